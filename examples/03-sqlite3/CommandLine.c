@@ -47,318 +47,255 @@ CommandLine_t * CreateCommandLine(int const argc,
 
     // Declare
     //////////////////////////////////////////////////////////////////////////
-    xo_args_arg const * const arg_ArchiveArgs =
-        xo_args_declare_arg(ctx,
-                            "A",
-                            "A",
-                            "ARGS...",
-                            "run \".archive ARGS\" and exit",
-                            XO_ARGS_TYPE_STRING_ARRAY);
-
-    xo_args_arg const * const arg_Append =
-        xo_args_declare_arg(ctx,
-                            "append",
-                            "append",
-                            NULL,
-                            "append the database to the end of the file",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_ASCII =
-        xo_args_declare_arg(ctx,
-                            "ascii",
-                            "ascii",
-                            NULL,
-                            "set output mode to 'ascii'",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Bail =
-        xo_args_declare_arg(ctx,
-                            "bail",
-                            "bail",
-                            NULL,
-                            "stop after hitting an error",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Batch = xo_args_declare_arg(
-        ctx, "batch", "batch", NULL, "force batch I/O", XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Box =
-        xo_args_declare_arg(ctx,
-                            "box",
-                            "box",
-                            NULL,
-                            "set output mode to 'box'",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Column =
-        xo_args_declare_arg(ctx,
-                            "column",
-                            "column",
-                            NULL,
-                            "set output mode to 'column'",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Command =
-        xo_args_declare_arg(ctx,
-                            "cmd",
-                            "cmd",
-                            "COMMAND",
-                            "run \"COMMAND\" before reading stdin",
-                            XO_ARGS_TYPE_STRING);
-
-    xo_args_arg const * const arg_CSV =
-        xo_args_declare_arg(ctx,
-                            "csv",
-                            "csv",
-                            NULL,
-                            "set output mode to 'csv'",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Deserialize =
-        xo_args_declare_arg(ctx,
-                            "deserialize",
-                            "deserialize",
-                            NULL,
-                            "open the database using sqlite3_deserialize()",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Echo =
-        xo_args_declare_arg(ctx,
-                            "echo",
-                            "echo",
-                            NULL,
-                            "print inputs before execution",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_InitFilename =
-        xo_args_declare_arg(ctx,
-                            "init",
-                            "init",
-                            "FILENAME",
-                            "read/process named file",
-                            XO_ARGS_TYPE_STRING);
-
-    xo_args_arg const * const arg_Header = xo_args_declare_arg(
-        ctx, "header", "header", NULL, "turn headers on", XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_HTML =
-        xo_args_declare_arg(ctx,
-                            "html",
-                            "html",
-                            NULL,
-                            "set output mode to HTML",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Interactive =
-        xo_args_declare_arg(ctx,
-                            "interactive",
-                            "interactive",
-                            NULL,
-                            "force interactive I/O",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_JSON =
-        xo_args_declare_arg(ctx,
-                            "json",
-                            "json",
-                            NULL,
-                            "set output mode to 'json'",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Line =
-        xo_args_declare_arg(ctx,
-                            "line",
-                            "line",
-                            NULL,
-                            "set output mode to 'line'",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_List =
-        xo_args_declare_arg(ctx,
-                            "list",
-                            "list",
-                            NULL,
-                            "set output mode to 'list'",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_LookAside =
-        xo_args_declare_arg(ctx,
-                            "lookaside",
-                            "lookaside",
-                            "SIZE N",
-                            "use N entries of SZ bytes for lookaside memory",
-                            XO_ARGS_TYPE_INT_ARRAY);
-
-    xo_args_arg const * const arg_Markdown =
-        xo_args_declare_arg(ctx,
-                            "markdown",
-                            "markdown",
-                            NULL,
-                            "set output mode to 'markdown'",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_MaxSize =
-        xo_args_declare_arg(ctx,
-                            "maxsize",
-                            "maxsize",
-                            "N",
-                            "maximum size for a --deserialize database",
-                            XO_ARGS_TYPE_INT);
-
-    xo_args_arg const * const arg_MemTrace =
-        xo_args_declare_arg(ctx,
-                            "memtrace",
-                            "memtrace",
-                            NULL,
-                            "trace all memory allocations and deallocations",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_MMap =
-        xo_args_declare_arg(ctx,
-                            "mmap",
-                            "mmap",
-                            "N",
-                            "default mmap size set to N",
-                            XO_ARGS_TYPE_INT);
-
-    xo_args_arg const * const arg_NewLine =
-        xo_args_declare_arg(ctx,
-                            "newline",
-                            "newline",
-                            "SEP",
-                            "set output row separator. Default: '\\n'",
-                            XO_ARGS_TYPE_STRING);
-
-    xo_args_arg const * const arg_NoFollow =
-        xo_args_declare_arg(ctx,
-                            "nofollow",
-                            "nofollow",
-                            NULL,
-                            "refuse to open symbolic links to database files",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Nonce =
-        xo_args_declare_arg(ctx,
-                            "nonce",
-                            "nonce",
-                            "STRING",
-                            "set the safe-mode escape nonce",
-                            XO_ARGS_TYPE_STRING);
-
-    xo_args_arg const * const arg_NoRowIDInView =
-        xo_args_declare_arg(ctx,
-                            "no-rowid-in-view",
-                            "no-rowid-in-view",
-                            NULL,
-                            "Disable rowid-in-view using sqlite3_config()",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_NullValue =
-        xo_args_declare_arg(ctx,
-                            "nullvalue",
-                            "nullvalue",
-                            "TEXT",
-                            "set text string for NULL values. Default ''",
-                            XO_ARGS_TYPE_STRING);
-
-    xo_args_arg const * const arg_PageCache = xo_args_declare_arg(
-        ctx,
-        "pagecache",
-        "pagecache",
-        "SIZE N",
-        "use N slots of SZ bytes each for page cache memory",
-        XO_ARGS_TYPE_INT_ARRAY);
-
-    xo_args_arg const * const arg_PageCacheTrace =
-        xo_args_declare_arg(ctx,
-                            "pcachetrace",
-                            "pcachetrace",
-                            NULL,
-                            "trace all page cache operations",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Quote =
-        xo_args_declare_arg(ctx,
-                            "quote",
-                            "quote",
-                            NULL,
-                            "set output mode to 'quote'",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Readonly =
-        xo_args_declare_arg(ctx,
-                            "readonly",
-                            "readonly",
-                            NULL,
-                            "open the database read-only",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Safe = xo_args_declare_arg(
-        ctx, "safe", "safe", NULL, "enable safe-mode", XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Separator =
-        xo_args_declare_arg(ctx,
-                            "separator",
-                            "separator",
-                            "SEP",
-                            "set output column separator. Default: '|'",
-                            XO_ARGS_TYPE_STRING);
-
-    xo_args_arg const * const arg_Stats =
-        xo_args_declare_arg(ctx,
-                            "stats",
-                            "stats",
-                            NULL,
-                            "print memory stats before each finalize",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Table =
-        xo_args_declare_arg(ctx,
-                            "table",
-                            "table",
-                            NULL,
-                            "set output mode to 'table'",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Tabs =
-        xo_args_declare_arg(ctx,
-                            "tabs",
-                            "tabs",
-                            NULL,
-                            "set output mode to 'tabs'",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_UnsafeTesting =
-        xo_args_declare_arg(ctx,
-                            "unsafe-testing",
-                            "unsafe-testing",
-                            NULL,
-                            "allow unsafe commands and modes for testing",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_VFSName =
-        xo_args_declare_arg(ctx,
-                            "vfs",
-                            "vfs",
-                            "NAME",
-                            "use NAME as the default VFS",
-                            XO_ARGS_TYPE_STRING);
-
-    xo_args_arg const * const arg_VFSTrace =
-        xo_args_declare_arg(ctx,
-                            "vfstrace",
-                            "vfstrace",
-                            NULL,
-                            "enable tracing of all VFS calls",
-                            XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * const arg_Zip =
-        xo_args_declare_arg(ctx,
-                            "zip",
-                            "zip",
-                            NULL,
-                            "open the file as a ZIP Archive",
-                            XO_ARGS_TYPE_SWITCH);
+    // The table and its strings are static so xo-args borrows them instead of
+    // copying each one.
+    enum
+    {
+        Arg_ArchiveArgs,
+        Arg_Append,
+        Arg_ASCII,
+        Arg_Bail,
+        Arg_Batch,
+        Arg_Box,
+        Arg_Column,
+        Arg_Command,
+        Arg_CSV,
+        Arg_Deserialize,
+        Arg_Echo,
+        Arg_InitFilename,
+        Arg_Header,
+        Arg_HTML,
+        Arg_Interactive,
+        Arg_JSON,
+        Arg_Line,
+        Arg_List,
+        Arg_LookAside,
+        Arg_Markdown,
+        Arg_MaxSize,
+        Arg_MemTrace,
+        Arg_MMap,
+        Arg_NewLine,
+        Arg_NoFollow,
+        Arg_Nonce,
+        Arg_NoRowIDInView,
+        Arg_NullValue,
+        Arg_PageCache,
+        Arg_PageCacheTrace,
+        Arg_Quote,
+        Arg_Readonly,
+        Arg_Safe,
+        Arg_Separator,
+        Arg_Stats,
+        Arg_Table,
+        Arg_Tabs,
+        Arg_UnsafeTesting,
+        Arg_VFSName,
+        Arg_VFSTrace,
+        Arg_Zip,
+        Arg_Count
+    };
+    static xo_args_arg_desc const s_Args[Arg_Count] = {
+        {"A",
+         "A",
+         "ARGS...",
+         "run \".archive ARGS\" and exit",
+         XO_ARGS_TYPE_STRING_ARRAY},
+        {"append",
+         "append",
+         NULL,
+         "append the database to the end of the file",
+         XO_ARGS_TYPE_SWITCH},
+        {"ascii",
+         "ascii",
+         NULL,
+         "set output mode to 'ascii'",
+         XO_ARGS_TYPE_SWITCH},
+        {"bail",
+         "bail",
+         NULL,
+         "stop after hitting an error",
+         XO_ARGS_TYPE_SWITCH},
+        {"batch", "batch", NULL, "force batch I/O", XO_ARGS_TYPE_SWITCH},
+        {"box", "box", NULL, "set output mode to 'box'", XO_ARGS_TYPE_SWITCH},
+        {"column",
+         "column",
+         NULL,
+         "set output mode to 'column'",
+         XO_ARGS_TYPE_SWITCH},
+        {"cmd",
+         "cmd",
+         "COMMAND",
+         "run \"COMMAND\" before reading stdin",
+         XO_ARGS_TYPE_STRING},
+        {"csv", "csv", NULL, "set output mode to 'csv'", XO_ARGS_TYPE_SWITCH},
+        {"deserialize",
+         "deserialize",
+         NULL,
+         "open the database using sqlite3_deserialize()",
+         XO_ARGS_TYPE_SWITCH},
+        {"echo",
+         "echo",
+         NULL,
+         "print inputs before execution",
+         XO_ARGS_TYPE_SWITCH},
+        {"init",
+         "init",
+         "FILENAME",
+         "read/process named file",
+         XO_ARGS_TYPE_STRING},
+        {"header", "header", NULL, "turn headers on", XO_ARGS_TYPE_SWITCH},
+        {"html", "html", NULL, "set output mode to HTML", XO_ARGS_TYPE_SWITCH},
+        {"interactive",
+         "interactive",
+         NULL,
+         "force interactive I/O",
+         XO_ARGS_TYPE_SWITCH},
+        {"json",
+         "json",
+         NULL,
+         "set output mode to 'json'",
+         XO_ARGS_TYPE_SWITCH},
+        {"line",
+         "line",
+         NULL,
+         "set output mode to 'line'",
+         XO_ARGS_TYPE_SWITCH},
+        {"list",
+         "list",
+         NULL,
+         "set output mode to 'list'",
+         XO_ARGS_TYPE_SWITCH},
+        {"lookaside",
+         "lookaside",
+         "SIZE N",
+         "use N entries of SZ bytes for lookaside memory",
+         XO_ARGS_TYPE_INT_ARRAY},
+        {"markdown",
+         "markdown",
+         NULL,
+         "set output mode to 'markdown'",
+         XO_ARGS_TYPE_SWITCH},
+        {"maxsize",
+         "maxsize",
+         "N",
+         "maximum size for a --deserialize database",
+         XO_ARGS_TYPE_INT},
+        {"memtrace",
+         "memtrace",
+         NULL,
+         "trace all memory allocations and deallocations",
+         XO_ARGS_TYPE_SWITCH},
+        {"mmap", "mmap", "N", "default mmap size set to N", XO_ARGS_TYPE_INT},
+        {"newline",
+         "newline",
+         "SEP",
+         "set output row separator. Default: '\\n'",
+         XO_ARGS_TYPE_STRING},
+        {"nofollow",
+         "nofollow",
+         NULL,
+         "refuse to open symbolic links to database files",
+         XO_ARGS_TYPE_SWITCH},
+        {"nonce",
+         "nonce",
+         "STRING",
+         "set the safe-mode escape nonce",
+         XO_ARGS_TYPE_STRING},
+        {"no-rowid-in-view",
+         "no-rowid-in-view",
+         NULL,
+         "Disable rowid-in-view using sqlite3_config()",
+         XO_ARGS_TYPE_SWITCH},
+        {"nullvalue",
+         "nullvalue",
+         "TEXT",
+         "set text string for NULL values. Default ''",
+         XO_ARGS_TYPE_STRING},
+        {"pagecache",
+         "pagecache",
+         "SIZE N",
+         "use N slots of SZ bytes each for page cache memory",
+         XO_ARGS_TYPE_INT_ARRAY},
+        {"pcachetrace",
+         "pcachetrace",
+         NULL,
+         "trace all page cache operations",
+         XO_ARGS_TYPE_SWITCH},
+        {"quote",
+         "quote",
+         NULL,
+         "set output mode to 'quote'",
+         XO_ARGS_TYPE_SWITCH},
+        {"readonly",
+         "readonly",
+         NULL,
+         "open the database read-only",
+         XO_ARGS_TYPE_SWITCH},
+        {"safe", "safe", NULL, "enable safe-mode", XO_ARGS_TYPE_SWITCH},
+        {"separator",
+         "separator",
+         "SEP",
+         "set output column separator. Default: '|'",
+         XO_ARGS_TYPE_STRING},
+        {"stats",
+         "stats",
+         NULL,
+         "print memory stats before each finalize",
+         XO_ARGS_TYPE_SWITCH},
+        {"table",
+         "table",
+         NULL,
+         "set output mode to 'table'",
+         XO_ARGS_TYPE_SWITCH},
+        {"tabs",
+         "tabs",
+         NULL,
+         "set output mode to 'tabs'",
+         XO_ARGS_TYPE_SWITCH},
+        {"unsafe-testing",
+         "unsafe-testing",
+         NULL,
+         "allow unsafe commands and modes for testing",
+         XO_ARGS_TYPE_SWITCH},
+        {"vfs",
+         "vfs",
+         "NAME",
+         "use NAME as the default VFS",
+         XO_ARGS_TYPE_STRING},
+        {"vfstrace",
+         "vfstrace",
+         NULL,
+         "enable tracing of all VFS calls",
+         XO_ARGS_TYPE_SWITCH},
+        {"zip",
+         "zip",
+         NULL,
+         "open the file as a ZIP Archive",
+         XO_ARGS_TYPE_SWITCH},
+    };
+
+    xo_args_arg * args[Arg_Count];
+    xo_args_declare_args(ctx, s_Args, Arg_Count, args);
+
+    // Flags are written straight into cmd when parsing succeeds. The remaining
+    // values need validating or copying and are extracted after submit.
+    xo_args_bind_bool(args[Arg_Append], &cmd->Append);
+    xo_args_bind_bool(args[Arg_Bail], &cmd->Bail);
+    xo_args_bind_bool(args[Arg_Batch], &cmd->Batch);
+    xo_args_bind_bool(args[Arg_Deserialize], &cmd->Deserialize);
+    xo_args_bind_bool(args[Arg_Echo], &cmd->Echo);
+    xo_args_bind_bool(args[Arg_Header], &cmd->Header);
+    xo_args_bind_bool(args[Arg_Interactive], &cmd->Interactive);
+    xo_args_bind_bool(args[Arg_MemTrace], &cmd->MemTrace);
+    xo_args_bind_bool(args[Arg_NoFollow], &cmd->NoFollow);
+    xo_args_bind_bool(args[Arg_NoRowIDInView], &cmd->NoRowIDInView);
+    xo_args_bind_bool(args[Arg_PageCacheTrace], &cmd->PageCacheTrace);
+    xo_args_bind_bool(args[Arg_Readonly], &cmd->Readonly);
+    xo_args_bind_bool(args[Arg_Safe], &cmd->Safe);
+    xo_args_bind_bool(args[Arg_Stats], &cmd->Stats);
+    xo_args_bind_bool(args[Arg_UnsafeTesting], &cmd->UnsafeTesting);
+    xo_args_bind_bool(args[Arg_VFSTrace], &cmd->VFSTrace);
+    xo_args_bind_bool(args[Arg_Zip], &cmd->Zip);
 
     // Submit
     //////////////////////////////////////////////////////////////////////////
@@ -374,74 +311,60 @@ CommandLine_t * CreateCommandLine(int const argc,
     //////////////////////////////////////////////////////////////////////////
 
     if (xo_args_try_get_string_array(
-            arg_ArchiveArgs, &cmd->ArchiveArgs, &cmd->ArchiveArgsCount))
+            args[Arg_ArchiveArgs], &cmd->ArchiveArgs, &cmd->ArchiveArgsCount))
     {
         cmd->ArchiveArgs =
             _DuplicateStringArray(cmd->ArchiveArgs, cmd->ArchiveArgsCount);
     }
 
-    xo_args_try_get_bool(arg_Append, &cmd->Append);
-
     bool ASCII;
-    if (xo_args_try_get_bool(arg_ASCII, &ASCII) && ASCII)
+    if (xo_args_try_get_bool(args[Arg_ASCII], &ASCII) && ASCII)
     {
         cmd->OutputMode |= OutputMode_ASCII;
     }
 
-    xo_args_try_get_bool(arg_Bail, &cmd->Bail);
-
-    xo_args_try_get_bool(arg_Batch, &cmd->Batch);
-
     bool box;
-    if (xo_args_try_get_bool(arg_Box, &box) && box)
+    if (xo_args_try_get_bool(args[Arg_Box], &box) && box)
     {
         cmd->OutputMode |= OutputMode_Box;
     }
 
     bool column;
-    if (xo_args_try_get_bool(arg_Column, &column) && column)
+    if (xo_args_try_get_bool(args[Arg_Column], &column) && column)
     {
         cmd->OutputMode |= OutputMode_Column;
     }
 
-    xo_args_try_get_string(arg_Command, &cmd->Command);
+    xo_args_try_get_string(args[Arg_Command], &cmd->Command);
 
     bool CSV;
-    if (xo_args_try_get_bool(arg_CSV, &CSV) && CSV)
+    if (xo_args_try_get_bool(args[Arg_CSV], &CSV) && CSV)
     {
         cmd->OutputMode |= OutputMode_CSV;
     }
 
-    xo_args_try_get_bool(arg_Deserialize, &cmd->Deserialize);
-
-    xo_args_try_get_bool(arg_Echo, &cmd->Echo);
-
-    xo_args_try_get_string(arg_InitFilename, &cmd->InitFilename);
-
-    xo_args_try_get_bool(arg_Header, &cmd->Header);
+    xo_args_try_get_string(args[Arg_InitFilename], &cmd->InitFilename);
 
     bool HTML;
-    if (xo_args_try_get_bool(arg_HTML, &HTML) && HTML)
+    if (xo_args_try_get_bool(args[Arg_HTML], &HTML) && HTML)
     {
         cmd->OutputMode |= OutputMode_HTML;
     }
 
-    xo_args_try_get_bool(arg_Interactive, &cmd->Interactive);
-
     bool JSON;
-    if (xo_args_try_get_bool(arg_JSON, &JSON) && JSON)
+    if (xo_args_try_get_bool(args[Arg_JSON], &JSON) && JSON)
     {
         cmd->OutputMode |= OutputMode_JSON;
     }
 
     bool line;
-    if (xo_args_try_get_bool(arg_Line, &line) && line)
+    if (xo_args_try_get_bool(args[Arg_Line], &line) && line)
     {
         cmd->OutputMode |= OutputMode_Line;
     }
 
     bool list;
-    if (xo_args_try_get_bool(arg_List, &list) && list)
+    if (xo_args_try_get_bool(args[Arg_List], &list) && list)
     {
         cmd->OutputMode |= OutputMode_List;
     }
@@ -449,7 +372,7 @@ CommandLine_t * CreateCommandLine(int const argc,
     int64_t const * lookasideArray;
     size_t lookasideArrayCount;
     if (xo_args_try_get_int_array(
-            arg_LookAside, &lookasideArray, &lookasideArrayCount))
+            args[Arg_LookAside], &lookasideArray, &lookasideArrayCount))
     {
         if (lookasideArrayCount != 2)
         {
@@ -485,13 +408,13 @@ CommandLine_t * CreateCommandLine(int const argc,
     }
 
     bool markdown;
-    if (xo_args_try_get_bool(arg_Markdown, &markdown) && markdown)
+    if (xo_args_try_get_bool(args[Arg_Markdown], &markdown) && markdown)
     {
         cmd->OutputMode |= OutputMode_Markdown;
     }
 
     int64_t maxSize = 0;
-    if (xo_args_try_get_int(arg_MaxSize, &maxSize))
+    if (xo_args_try_get_int(args[Arg_MaxSize], &maxSize))
     {
         if (false == cmd->Deserialize)
         {
@@ -512,10 +435,8 @@ CommandLine_t * CreateCommandLine(int const argc,
         cmd->MaxSize = (uint32_t)maxSize;
     }
 
-    xo_args_try_get_bool(arg_MemTrace, &cmd->MemTrace);
-
     int64_t MMapSize = 0;
-    if (xo_args_try_get_int(arg_MMap, &maxSize))
+    if (xo_args_try_get_int(args[Arg_MMap], &maxSize))
     {
         if (MMapSize <= 0 || MMapSize > UINT32_MAX)
         {
@@ -528,7 +449,7 @@ CommandLine_t * CreateCommandLine(int const argc,
         cmd->MMap = (uint32_t)MMapSize;
     }
 
-    if (xo_args_try_get_string(arg_NewLine, &cmd->NewLine))
+    if (xo_args_try_get_string(args[Arg_NewLine], &cmd->NewLine))
     {
         cmd->NewLine = _DuplicateString(cmd->NewLine);
     }
@@ -537,15 +458,12 @@ CommandLine_t * CreateCommandLine(int const argc,
         cmd->NewLine = _DuplicateString("\n");
     }
 
-    xo_args_try_get_bool(arg_NoFollow, &cmd->NoFollow);
-    if (xo_args_try_get_string(arg_Nonce, &cmd->Nonce))
+    if (xo_args_try_get_string(args[Arg_Nonce], &cmd->Nonce))
     {
         cmd->Nonce = _DuplicateString(cmd->Nonce);
     }
 
-    xo_args_try_get_bool(arg_NoRowIDInView, &cmd->NoRowIDInView);
-
-    if (xo_args_try_get_string(arg_NullValue, &cmd->NullValue))
+    if (xo_args_try_get_string(args[Arg_NullValue], &cmd->NullValue))
     {
         cmd->NullValue = _DuplicateString(cmd->NullValue);
     }
@@ -557,7 +475,7 @@ CommandLine_t * CreateCommandLine(int const argc,
     int64_t const * pageCacheArray;
     size_t pageCacheArrayCount;
     if (xo_args_try_get_int_array(
-            arg_PageCache, &pageCacheArray, &pageCacheArrayCount))
+            args[Arg_PageCache], &pageCacheArray, &pageCacheArrayCount))
     {
         if (pageCacheArrayCount != 2)
         {
@@ -591,19 +509,13 @@ CommandLine_t * CreateCommandLine(int const argc,
         cmd->PageCacheSize = (uint32_t)pageCacheArray[1];
     }
 
-    xo_args_try_get_bool(arg_PageCacheTrace, &cmd->PageCacheTrace);
-
     bool quote;
-    if (xo_args_try_get_bool(arg_Quote, &quote) && quote)
+    if (xo_args_try_get_bool(args[Arg_Quote], &quote) && quote)
     {
         cmd->OutputMode |= OutputMode_Quote;
     }
 
-    xo_args_try_get_bool(arg_Readonly, &cmd->Readonly);
-
-    xo_args_try_get_bool(arg_Safe, &cmd->Safe);
-
-    if (xo_args_try_get_string(arg_Separator, &cmd->Separator))
+    if (xo_args_try_get_string(args[Arg_Separator], &cmd->Separator))
     {
         cmd->Separator = _DuplicateString(cmd->Separator);
     }
@@ -612,31 +524,23 @@ CommandLine_t * CreateCommandLine(int const argc,
         cmd->Separator = _DuplicateString("|");
     }
 
-    xo_args_try_get_bool(arg_Stats, &cmd->Stats);
-
     bool table;
-    if (xo_args_try_get_bool(arg_Table, &table) && table)
+    if (xo_args_try_get_bool(args[Arg_Table], &table) && table)
     {
         cmd->OutputMode |= OutputMode_Table;
     }
 
     bool tabs;
-    if (xo_args_try_get_bool(arg_Tabs, &tabs) && tabs)
+    if (xo_args_try_get_bool(args[Arg_Tabs], &tabs) && tabs)
     {
         cmd->OutputMode |= OutputMode_Tabs;
     }
 
-    xo_args_try_get_bool(arg_UnsafeTesting, &cmd->UnsafeTesting);
-
-    if (xo_args_try_get_string(arg_VFSName, &cmd->VFS))
+    if (xo_args_try_get_string(args[Arg_VFSName], &cmd->VFS))
     {
         cmd->VFS = _DuplicateString(cmd->VFS);
     }
 
-    xo_args_try_get_bool(arg_VFSTrace, &cmd->VFSTrace);
-
-    xo_args_try_get_bool(arg_Zip, &cmd->Zip);
-
     // Additional Validations
     //////////////////////////////////////////////////////////////////////////
     size_t outputTypeTemp = cmd->OutputMode;
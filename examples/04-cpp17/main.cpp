@@ -0,0 +1,62 @@
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+#include <xo-args/xo-args.hpp>
+
+// The same program as 02-cpp with its arguments declared at compile time.
+// Renaming "repeat" to "message" (or its short name to "h") would fail to
+// compile rather than fail when the program runs.
+constexpr xo_args::option<std::string_view> message{
+    "message",
+    "m",
+    "MSG",
+    "a message to print to stdout some number of times (see: --repeat)",
+    true};
+
+constexpr xo_args::option<int64_t> repeat{
+    "repeat", "r", "COUNT", "the number of times to print the message"};
+
+constexpr xo_args::option<xo_args::switch_t> verbose{
+    "verbose", "V", nullptr, "print additional info"};
+
+int main(int argc, char ** argv)
+{
+    // We'll use mock data for argc/argv in this example
+    (void)argc; // unused
+    (void)argv; // unused
+    char const * const mock_argv[] = {
+        "/mock/cpp17.exe", "-m", "Hello World!", "-r=5", "-V"};
+    int const mock_argc = sizeof(mock_argv) / sizeof(mock_argv[0]);
+
+    xo_args_ctx_options options = {};
+    options.app_name = "04-cpp17";
+    options.app_version = "1.0.0";
+    options.app_documentation =
+        "This app is an example demonstration using xo-args.hpp.";
+
+    xo_args::parser<message, repeat, verbose> args(
+        mock_argc, mock_argv, &options);
+    if (!args.submit())
+    {
+        return -1;
+    }
+
+    std::string_view const message_value = *args.get<message>();
+    int64_t const repeat_value = args.get<repeat>().value_or(10);
+    if (args.get<verbose>())
+    {
+        std::cout << "verbose = true" << std::endl
+                  << "message = \"" << message_value << "\"" << std::endl
+                  << "repeat = " << repeat_value << std::endl;
+    }
+
+    for (int64_t i = 0; i < repeat_value; ++i)
+    {
+        std::cout << message_value << std::endl;
+    }
+    return 0;
+}
+
+#define XO_ARGS_IMPL
+#include <xo-args/xo-args.h>
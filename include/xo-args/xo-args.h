@@ -42,9 +42,29 @@
 //          xo_args_create_ctx          -- Creates the context
 //          xo_args_create_ctx_advanced -- A more feature-rich alternative to
 //                                         xo_args_create_ctx
+//          xo_args_create_ctx_with_options
+//                                      -- Like xo_args_create_ctx_advanced
+//                                         with additional context flags
 //          xo_args_declare_arg         -- Declares an argument
+//          xo_args_declare_args        -- Declares a table of arguments
+//          xo_args_set_capacity_hint   -- Reserves room for an array's values
+//          xo_args_set_value_callback  -- Streams an array's values to a
+//                                         function instead of storing them
 //          xo_args_submit              -- Begins argument parsing
+//          xo_args_feed, xo_args_finish
+//                                      -- An alternative to xo_args_submit
+//                                         for arguments fed one at a time
+//          xo_args_reset_values        -- Prepares a context to parse another
+//                                         argv with the same arguments
+//          xo_args_freeze_schema       -- Makes a context a read-only schema
+//          xo_args_create_ctx_from_schema
+//                                      -- Creates a context that parses with
+//                                         the arguments of a schema
+//          xo_args_validate_batch      -- Checks many command lines against a
+//                                         schema on worker threads
 //          xo_args_destroy_ctx         -- Cleans up the context
+//          xo_args_get_stats           -- Reports what the context has cost
+//                                         (with XO_ARGS_STATS only)
 //
 //  Declaring arguments:
 //      Every argument must have a name. That name is specified by users on the
@@ -61,12 +81,131 @@
 //      Arguments are optional by default. Use the XO_ARGS_ARG_REQUIRED flag to
 //      indicate than an argument is required.
 //
+//  Argument tables:
+//      Programs with many arguments can describe them in a table and declare
+//      them with a single call to xo_args_declare_args:
+//
+//          static xo_args_arg_desc const foo_args[] = {
+//              {"verbose", "V", NULL, "Print more", XO_ARGS_TYPE_SWITCH},
+//              {"timeout", "t", "SECONDS", NULL, XO_ARGS_TYPE_DOUBLE},
+//          };
+//          xo_args_arg * args[2];
+//          xo_args_declare_args(ctx, foo_args, 2, args);
+//
+//      The strings in the table are not copied and all of the arguments share
+//      one allocation. Name conflicts are checked once for the whole table.
+//
+//  Binding values:
+//      Instead of calling a getter for every argument after xo_args_submit,
+//      arguments can be bound to variables which receive their values once
+//      parsing succeeds:
+//
+//          int64_t jobs = 4; // the default when --jobs is not given
+//          xo_args_bind_int(jobs_arg, &jobs);
+//          xo_args_submit(ctx);
+//
+//      See xo_args_bind_string and its neighbours below.
+//
+//  Shared schemas:
+//      Programs that parse many command lines with the same arguments (for
+//      example to validate the command lines of many jobs at once) can
+//      declare the arguments once. Declare them on a context as usual and
+//      freeze it, then create one context per command line from it:
+//
+//          xo_args_freeze_schema(schema);
+//          xo_args_ctx * job = xo_args_create_ctx_from_schema(
+//              schema, job_argc, job_argv);
+//          xo_args_submit(job);
+//          xo_args_try_get_int(xo_args_get_schema_arg(job, jobs_arg), &jobs);
+//
+//      A frozen schema is never modified again, so contexts created from it
+//      can be used on different threads at the same time. They share the
+//      schema's names, name index and cached help text and only hold values
+//      of their own. The schema must outlive them.
+//
+//      xo_args_validate_batch checks many command lines against a schema on
+//      a pool of worker threads. Instead of being printed, the errors of each
+//      command line are collected into a result that can be inspected
+//      afterwards. Define XO_ARGS_NO_THREADS to validate every command line
+//      on the calling thread instead. On POSIX systems threads are pthreads,
+//      so link with -pthread where the C library needs it.
+//
+//  Memory:
+//      By default every string and array owned by a context is its own
+//      allocation. Creating the context with the XO_ARGS_CTX_ARENA flag (see
+//      xo_args_create_ctx_with_options) instead carves all of that memory out
+//      of a few large chunks which are released together when the context is
+//      destroyed. The XO_ARGS_CTX_BORROW_ARGV flag skips copying string values
+//      entirely and hands out pointers into argv.
+//
 //  Data types:
 //      xo-args supports strings, integers, doubles and booleans. There are also
 //      array types for each of those data types. The integer type is backed by
 //      int64_t with all the limitations that implies; similarly, doubles are
 //      backed by the double type.
 //
+//      Integers accept the same syntax as strtoll with base 0 (decimal, 0x
+//      hexadecimal and 0 octal) and doubles accept the same syntax as strtod
+//      in the "C" locale, including hexadecimal floats, inf and nan. Both are
+//      parsed by xo-args itself, so the result does not depend on the current
+//      locale and doubles are always correctly rounded. Values that are out of
+//      range (where strtod would report ERANGE) are rejected. Define
+//      XO_ARGS_USE_STRTOD before including the implementation to parse
+//      doubles with strtod instead.
+//
+//      Each value of an integer or double array can also be a list of values
+//      separated by commas and/or whitespace. This makes it practical to pass
+//      very large arrays as a single token:
+//
+//          foo.exe --ids=1,2,3,4 --weights "0.5 0.25 0.25"
+//
+//      When a list is assigned with '=' (as with --ids above) the array does
+//      not continue into the tokens that follow it.
+//
+//  Response files:
+//      Command lines that are too long for the operating system can be passed
+//      in files instead. With the XO_ARGS_CTX_RESPONSE_FILES flag any argument
+//      of the form @path is replaced by the arguments in the file at path:
+//
+//          foo.exe @build.rsp --verbose
+//
+//      Arguments in the file are separated by whitespace. Single or double
+//      quotes keep whitespace in an argument and a backslash escapes the
+//      character after it. Response files may refer to other response files.
+//      If the file cannot be read @path is kept as an ordinary argument.
+//
+//      Files are memory-mapped where the platform supports it (define
+//      XO_ARGS_NO_MMAP to read them into memory instead) and split into
+//      arguments in place, so even very large files are not copied argument
+//      by argument. The values of string arguments read from a response file
+//      point into the file's memory, which is released by xo_args_reset_values
+//      or xo_args_destroy_ctx. Copy any such value that must outlive either.
+//
+//  Large arrays:
+//      When an integer or double array is given a long run of values (such as
+//      hundreds of thousands of values from a response file) xo_args_submit
+//      converts the run on a few threads at once, straight into the array.
+//      Runs shorter than twice XO_ARGS_PARALLEL_VALUES (8192 by default) are
+//      converted on the calling thread, as are arrays with a value callback.
+//      The result and any error are the same as converting one value at a
+//      time. The value_threads option of xo_args_create_ctx_with_options
+//      limits the threads used, and XO_ARGS_NO_THREADS turns this off.
+//
+//  Statistics:
+//      Define XO_ARGS_STATS in every file that includes xo-args.h to have each
+//      context count its tracked allocations and the bytes they requested,
+//      the tokens it parsed, the arguments it compared against those tokens
+//      and the time spent declaring, parsing and rendering help. Read them
+//      with xo_args_get_stats. Without XO_ARGS_STATS none of this is compiled.
+//
+//      Times come from a monotonic clock where one is available, otherwise
+//      from clock(). Define XO_ARGS_STATS_CLOCK_NS as an expression giving
+//      nanoseconds (as uint64_t) to use a clock of your own.
+//
+//      xo_args_render_help and xo_args_print_help add to help_ns even though
+//      they take a const context. A frozen schema is the exception: once
+//      frozen it records nothing more, so it can still be shared by threads.
+//
 //  User experience:
 //      Suppose you declare an application 'foo.exe' that takes a "verbose"/"V"
 //      switch, a double "timeout"/"t", a string array "input"/"i" and a string
@@ -144,6 +283,110 @@ extern "C"
         XO_ARGS_ARG_REQUIRED = 1 << 9
     } XO_ARGS_ARG_FLAG;
 
+    // Bit-flags for creating an xo-args context with
+    // xo_args_create_ctx_with_options.
+    typedef enum XO_ARGS_CTX_FLAG
+    {
+        XO_ARGS_CTX_DEFAULT = 0,
+
+        // Allocate all memory owned by the context (names, descriptions,
+        // values, arrays, etc.) from large bump-allocated chunks. Freeing
+        // individual values is a no-op and the chunks are released when the
+        // context is destroyed.
+        XO_ARGS_CTX_ARENA = 1 << 0,
+
+        // String values are not copied: xo_args_try_get_string and
+        // xo_args_try_get_string_array return pointers into argv. For
+        // "--name=value" and "-n=value" the pointer is to the first character
+        // after '='. argv must outlive the context when this flag is set.
+        XO_ARGS_CTX_BORROW_ARGV = 1 << 1,
+
+        // Render the help text once during xo_args_submit and keep it in the
+        // context. xo_args_print_help, xo_args_render_help and
+        // xo_args_get_help print or copy the cached text instead of rendering
+        // it again. Declaring another argument discards the cache.
+        XO_ARGS_CTX_CACHE_HELP = 1 << 2,
+
+        // Expand "@path" arguments into the arguments read from the file at
+        // path during xo_args_submit. See "Response files" above.
+        XO_ARGS_CTX_RESPONSE_FILES = 1 << 3
+    } XO_ARGS_CTX_FLAG;
+
+    // Options for xo_args_create_ctx_with_options. Zero-initialize this
+    // structure and fill in only what you need: every member is optional.
+    typedef struct xo_args_ctx_options
+    {
+        // See: xo_args_create_ctx_advanced
+        char const * app_name;
+        char const * app_version;
+        char const * app_documentation;
+        xo_args_alloc_fn alloc_fn;
+        xo_args_realloc_fn realloc_fn;
+        xo_args_free_fn free_fn;
+        xo_args_print_fn print_fn;
+
+        // A combination of XO_ARGS_CTX_FLAG values.
+        XO_ARGS_CTX_FLAG flags;
+
+        // The size in bytes of each chunk when XO_ARGS_CTX_ARENA is set.
+        // 0 selects a default of 4096.
+        size_t arena_chunk_size;
+
+        // The most threads that convert one long run of values given to an
+        // integer or double array (see "Large arrays"). 0 selects the number
+        // of processors and 1 converts every value on the calling thread.
+        size_t value_threads;
+    } xo_args_ctx_options;
+
+#if defined(XO_ARGS_STATS)
+    // What a context has cost since it was created. See "Statistics" above.
+    typedef struct xo_args_stats
+    {
+        size_t allocations;        // tracked allocations made
+        size_t reallocations;      // tracked allocations resized
+        size_t bytes_requested;    // bytes asked for by both of the above
+        size_t peak_tracked_bytes; // most bytes held in tracked allocations
+        size_t tokens_scanned;     // tokens parsed (argv and response files)
+        size_t match_attempts;     // arguments compared against a token
+
+        // Nanoseconds spent declaring arguments, parsing (xo_args_submit or
+        // xo_args_feed and xo_args_finish) and rendering help text. Help text
+        // rendered while parsing counts towards both submit_ns and help_ns.
+        uint64_t declare_ns;
+        uint64_t submit_ns;
+        uint64_t help_ns;
+    } xo_args_stats;
+#endif
+
+    // One entry of an argument table for xo_args_declare_args. The members
+    // have the same meaning as the parameters of xo_args_declare_arg.
+    typedef struct xo_args_arg_desc
+    {
+        char const * name;
+        char const * short_name;
+        char const * value_tip;
+        char const * description;
+        XO_ARGS_ARG_FLAG flags;
+    } xo_args_arg_desc;
+
+    // One command line for xo_args_validate_batch.
+    typedef struct xo_args_job
+    {
+        xo_argc_t argc;
+        xo_argv_t argv;
+    } xo_args_job;
+
+    // The results of xo_args_validate_batch.
+    typedef struct xo_args_batch xo_args_batch;
+
+    // Receives the values of an array argument one at a time (see
+    // xo_args_set_value_callback). value points to one element of the
+    // array's type: int64_t, double, bool or char const *. It is only valid
+    // during the call. Return false to reject the value, which fails parsing.
+    typedef bool (*xo_args_value_fn)(xo_args_arg const * const arg,
+                                     void const * const value,
+                                     void * const user_data);
+
     ////////////////////////////////////////////////////////////////////////////
     // Creates an xo-args context to be used with other API functions.
     // argc, argv: required program arguments
@@ -177,6 +420,17 @@ extern "C"
     xo_args_ctx * xo_args_create_ctx(xo_argc_t const argc,
                                      xo_argv_t const argv);
 
+    ////////////////////////////////////////////////////////////////////////////
+    // Creates an xo-args context to be used with other API functions.
+    // argc, argv: required program arguments
+    //
+    // options: optional settings for the context. NULL is equivalent to a
+    // zero-initialized xo_args_ctx_options.
+    xo_args_ctx * xo_args_create_ctx_with_options(
+        xo_argc_t const argc,
+        xo_argv_t const argv,
+        xo_args_ctx_options const * const options);
+
     ////////////////////////////////////////////////////////////////////////////
     // xo_args_submit concludes the setup of xo-args and parses all arguments.
     // If xo_args_submit returns true: the arguments are valid and can be used.
@@ -184,6 +438,108 @@ extern "C"
     // --help/-h or --version/-v arguments were provided.
     bool xo_args_submit(xo_args_ctx * const context);
 
+    ////////////////////////////////////////////////////////////////////////////
+    // xo_args_feed and xo_args_finish are an alternative to xo_args_submit for
+    // arguments that arrive over time, such as from a pipe or a generator.
+    // Each call to xo_args_feed parses one more argument as if it were appended
+    // to argv, so array arguments keep growing across calls. The arguments in
+    // the context's own argv (after argv[0]) are parsed first.
+    //
+    // token is not referenced after xo_args_feed returns unless the context
+    // was created with XO_ARGS_CTX_BORROW_ARGV, in which case string values
+    // point into it and it must outlive the context. All arguments must be
+    // declared before the first call to xo_args_feed.
+    //
+    // Returns false if token is invalid. Once a token is invalid every later
+    // call to xo_args_feed returns false.
+    bool xo_args_feed(xo_args_ctx * const context, char const * const token);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Concludes parsing that was started with xo_args_feed. The return value
+    // has the same meaning as the return value of xo_args_submit. Calling
+    // xo_args_finish without feeding anything is equivalent to
+    // xo_args_submit.
+    bool xo_args_finish(xo_args_ctx * const context);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Prepares a context to parse a new argc and argv with xo_args_submit (or
+    // xo_args_feed) without declaring its arguments again. Every argument
+    // loses its value and arrays become empty. Declarations, the name index,
+    // cached help text and memory reserved for values are kept so parsing
+    // again only costs the matching work.
+    //
+    // Values from the previous parse are invalid after this call. The app name
+    // is not derived from the new argv[0].
+    void xo_args_reset_values(xo_args_ctx * const context,
+                              xo_argc_t const argc,
+                              xo_argv_t const argv);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Finishes the declarations of a context so it can be used as a schema by
+    // xo_args_create_ctx_from_schema. The built-in arguments are declared, the
+    // name index is built and with XO_ARGS_CTX_CACHE_HELP the help text is
+    // rendered. Nothing can be declared, submitted or fed afterwards; the
+    // argv the schema was created with is never parsed.
+    //
+    // Returns false if the context has already started parsing.
+    bool xo_args_freeze_schema(xo_args_ctx * const context);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Creates a context that parses argc and argv with the arguments of a
+    // frozen schema (see "Shared schemas" above). It uses the schema's app
+    // name, version, documentation, allocator, print function and flags.
+    // Arguments can not be declared on it.
+    //
+    // Settings made on the schema's arguments (capacity hints, value
+    // callbacks and bindings) are inherited. Make them on the arguments of
+    // the new context instead when it is used alongside others on different
+    // threads.
+    xo_args_ctx * xo_args_create_ctx_from_schema(
+        xo_args_ctx const * const schema,
+        xo_argc_t const argc,
+        xo_argv_t const argv);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Returns the argument of context that corresponds to schema_arg, an
+    // argument declared on the schema context was created from. Values are
+    // read from (and bindings made on) the returned argument. For a context
+    // that was not created from a schema this returns schema_arg itself.
+    xo_args_arg * xo_args_get_schema_arg(xo_args_ctx const * const context,
+                                         xo_args_arg const * const schema_arg);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Parses every job with the arguments of a frozen schema as
+    // xo_args_submit would and collects the results. Jobs are shared out
+    // between thread_count threads (the calling thread is one of them);
+    // 0 uses one thread per processor. Each thread parses its jobs with a
+    // single context created from the schema.
+    //
+    // Nothing is printed: what xo_args_submit would print for a job is kept
+    // in the result instead. A job that asks for --help or --version is not
+    // valid, like the return value of xo_args_submit. Values are not kept, so
+    // value callbacks and bindings on the schema's arguments must not be set.
+    //
+    // The jobs must stay valid until this returns. Returns NULL if schema is
+    // not a frozen context. Destroy the result with xo_args_destroy_batch.
+    xo_args_batch * xo_args_validate_batch(xo_args_ctx const * const schema,
+                                           xo_args_job const * const jobs,
+                                           size_t const job_count,
+                                           size_t const thread_count);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // The number of jobs in batch that are not valid.
+    size_t xo_args_batch_invalid_count(xo_args_batch const * const batch);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Returns NULL if job (an index into the jobs given to
+    // xo_args_validate_batch) is valid. Otherwise returns what
+    // xo_args_submit would have printed for it. The text is owned by batch.
+    char const * xo_args_batch_get_errors(xo_args_batch const * const batch,
+                                          size_t const job);
+
+    ////////////////////////////////////////////////////////////////////////////
+    void xo_args_destroy_batch(xo_args_batch * const batch);
+
     ////////////////////////////////////////////////////////////////////////////
     // Destroys the xo-args context and all memory tracked by xo-args.
     void xo_args_destroy_ctx(xo_args_ctx * const context);
@@ -197,12 +553,45 @@ extern "C"
     // true.
     void xo_args_print_help(xo_args_ctx const * const context);
 
+    ////////////////////////////////////////////////////////////////////////////
+    // Renders the generated help text into buffer without printing it.
+    //
+    // Like snprintf: at most buffer_size - 1 characters are written and the
+    // result is always null terminated when buffer_size is not 0. Returns the
+    // length of the full help text (not counting the null terminator), so a
+    // return value >= buffer_size means the text was truncated. Pass a NULL
+    // buffer to only measure the text.
+    size_t xo_args_render_help(xo_args_ctx const * const context,
+                               char * const buffer,
+                               size_t const buffer_size);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Gets the help text cached by a context created with
+    // XO_ARGS_CTX_CACHE_HELP. The text is null terminated and owned by the
+    // context.
+    //
+    // out_length (optional): receives the length of the text.
+    //
+    // Returns NULL if the context has no cached help text, either because the
+    // flag was not set, xo_args_submit has not been called yet or an argument
+    // was declared after it.
+    char const * xo_args_get_help(xo_args_ctx const * const context,
+                                  size_t * const out_length);
+
     ////////////////////////////////////////////////////////////////////////////
     // Prints the version text specified when creating the xo-args context.
     // Version text can only be printed if a version string was provided via
     // xo_args_create_ctx_advanced.
     void xo_args_print_version(xo_args_ctx const * const context);
 
+#if defined(XO_ARGS_STATS)
+    ////////////////////////////////////////////////////////////////////////////
+    // Gets what the context has cost since it was created. Only available when
+    // XO_ARGS_STATS is defined.
+    void xo_args_get_stats(xo_args_ctx const * const context,
+                           xo_args_stats * const out_stats);
+#endif
+
     ////////////////////////////////////////////////////////////////////////////
     // Declares a program argument.
     //
@@ -235,6 +624,51 @@ extern "C"
                                       XO_ARGS_ARG_FLAG const flags);
 
     ////////////////////////////////////////////////////////////////////////////
+    // Declares every argument in a table at once. See "Argument tables" above.
+    //
+    // descs: count argument descriptions. The table and every string it points
+    // to are borrowed rather than copied: they must outlive the context (a
+    // static table is the usual choice).
+    //
+    // out_args (optional): count pointers which receive the declared arguments
+    // in table order.
+    //
+    // Returns false without declaring anything if a description is invalid or
+    // a name conflicts with another name in the table or an argument declared
+    // earlier.
+    bool xo_args_declare_args(xo_args_ctx * const context,
+                              xo_args_arg_desc const * const descs,
+                              size_t const count,
+                              xo_args_arg ** const out_args);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Tells xo-args how many values an array argument is expected to hold so
+    // its storage is reserved once instead of grown as values arrive. This is
+    // most useful with xo_args_feed: xo_args_submit already reserves room for
+    // every value it can see in argv. The hint is kept by
+    // xo_args_reset_values.
+    //
+    // arg must be an array argument.
+    void xo_args_set_capacity_hint(xo_args_arg * const arg,
+                                   size_t const capacity);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Hands each value of an array argument to value_fn as soon as it is
+    // parsed instead of storing it, so very long arrays are processed with
+    // constant memory. The array getters (and bindings) report an empty array
+    // for arg, but it still counts as given for XO_ARGS_ARG_REQUIRED.
+    //
+    // String values are not copied: they point into argv (or a response
+    // file). Pass a NULL value_fn to store values again.
+    //
+    // arg must be an array argument.
+    void xo_args_set_value_callback(xo_args_arg * const arg,
+                                    xo_args_value_fn const value_fn,
+                                    void * const user_data);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // The string is owned by the context unless it was created with
+    // XO_ARGS_CTX_BORROW_ARGV in which case it points into argv.
     bool xo_args_try_get_string(xo_args_arg const * const arg,
                                 char const ** out_string);
 
@@ -249,10 +683,29 @@ extern "C"
     bool xo_args_try_get_bool(xo_args_arg const * const arg, bool * out_bool);
 
     ////////////////////////////////////////////////////////////////////////////
+    // The array is owned by the context. Its strings are too unless the
+    // context was created with XO_ARGS_CTX_BORROW_ARGV in which case they point
+    // into argv.
     bool xo_args_try_get_string_array(xo_args_arg const * const arg,
                                       char const *** out_string_array,
                                       size_t * out_array_count);
 
+    ////////////////////////////////////////////////////////////////////////////
+    // Gets a string array in its packed form: all strings stored back to back
+    // in out_chars, each followed by a null terminator. String i starts at
+    // out_chars + out_offsets[i] and is out_lengths[i] characters long (not
+    // counting the terminator). The strings returned by
+    // xo_args_try_get_string_array point into the same memory.
+    //
+    // Returns false if the argument has no value or if the context was
+    // created with XO_ARGS_CTX_BORROW_ARGV (values are not copied in that
+    // mode so there is no packed form).
+    bool xo_args_try_get_string_array_packed(xo_args_arg const * const arg,
+                                             char const ** out_chars,
+                                             size_t const ** out_offsets,
+                                             size_t const ** out_lengths,
+                                             size_t * out_array_count);
+
     ////////////////////////////////////////////////////////////////////////////
     bool xo_args_try_get_int_array(xo_args_arg const * const arg,
                                    int64_t const ** out_int_array,
@@ -268,6 +721,53 @@ extern "C"
                                     bool const ** out_bool_array,
                                     size_t * out_array_count);
 
+    ////////////////////////////////////////////////////////////////////////////
+    // Binds an argument to storage owned by the caller. When parsing succeeds
+    // the value of the argument is written into out_string (or out_int etc.)
+    // so no getter is needed afterwards. Storage of an argument that is not
+    // given, and all bound storage when parsing fails, is left untouched,
+    // which makes it the natural place for a default value. Switches can be
+    // bound with xo_args_bind_bool and write true.
+    //
+    // Bind after declaring the argument and before xo_args_submit (or the
+    // first xo_args_feed). The storage must stay valid until parsing is
+    // finished. Strings written to it are owned by the context exactly as if
+    // they had been returned by a getter.
+    void xo_args_bind_string(xo_args_arg * const arg,
+                             char const ** const out_string);
+
+    ////////////////////////////////////////////////////////////////////////////
+    void xo_args_bind_int(xo_args_arg * const arg, int64_t * const out_int);
+
+    ////////////////////////////////////////////////////////////////////////////
+    void xo_args_bind_double(xo_args_arg * const arg,
+                             double * const out_double);
+
+    ////////////////////////////////////////////////////////////////////////////
+    void xo_args_bind_bool(xo_args_arg * const arg, bool * const out_bool);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // The array written to bound storage is owned by the context as with
+    // xo_args_try_get_string_array.
+    void xo_args_bind_string_array(xo_args_arg * const arg,
+                                   char const *** const out_string_array,
+                                   size_t * const out_array_count);
+
+    ////////////////////////////////////////////////////////////////////////////
+    void xo_args_bind_int_array(xo_args_arg * const arg,
+                                int64_t const ** const out_int_array,
+                                size_t * const out_array_count);
+
+    ////////////////////////////////////////////////////////////////////////////
+    void xo_args_bind_double_array(xo_args_arg * const arg,
+                                   double const ** const out_double_array,
+                                   size_t * const out_array_count);
+
+    ////////////////////////////////////////////////////////////////////////////
+    void xo_args_bind_bool_array(xo_args_arg * const arg,
+                                 bool const ** const out_bool_array,
+                                 size_t * const out_array_count);
+
 #if defined(__cplusplus)
 } // extern "C"
 #endif // defined(__cplusplus)
@@ -283,9 +783,93 @@ extern "C"
 #include <stdlib.h>
 #include <string.h>
 
+// SSE2 is used to scan delimited lists of array values 16 bytes at a time.
+// Define XO_ARGS_NO_SIMD to use the portable scalar code instead.
+#if !defined(XO_ARGS_NO_SIMD)                                                  \
+    && (defined(__SSE2__) || defined(_M_X64)                                   \
+        || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define _XO_ARGS_SSE2
+#include <emmintrin.h>
+#endif
+
+// Response files are memory-mapped on POSIX systems. Define XO_ARGS_NO_MMAP to
+// read them with stdio instead.
+#if !defined(XO_ARGS_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define _XO_ARGS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// xo_args_validate_batch and the conversion of long runs of array values use
+// threads where the platform has them. Define XO_ARGS_NO_THREADS to do all of
+// that work on the calling thread.
+#if !defined(XO_ARGS_NO_THREADS) && defined(_WIN32)
+#define _XO_ARGS_WIN32_THREADS
+#include <windows.h>
+#elif !defined(XO_ARGS_NO_THREADS)                                             \
+    && (defined(__unix__) || defined(__APPLE__))
+#define _XO_ARGS_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#if defined(_MSC_VER)
+#define _XO_ARGS_THREAD_LOCAL __declspec(thread)
+#elif defined(_XO_ARGS_WIN32_THREADS) || defined(_XO_ARGS_PTHREADS)
+#define _XO_ARGS_THREAD_LOCAL __thread
+#else
+#define _XO_ARGS_THREAD_LOCAL
+#endif
+#include <stdarg.h>
+
+// The number of jobs a worker of xo_args_validate_batch takes at a time.
+#if !defined(XO_ARGS_BATCH_CHUNK)
+#define XO_ARGS_BATCH_CHUNK 64
+#endif
+
+// The fewest values of an integer or double array that one thread converts.
+// See "Large arrays".
+#if !defined(XO_ARGS_PARALLEL_VALUES)
+#define XO_ARGS_PARALLEL_VALUES 8192
+#endif
+
+// With XO_ARGS_STATS the time spent in the API is measured with this clock.
+// Define XO_ARGS_STATS_CLOCK_NS as an expression giving a uint64_t count of
+// nanoseconds to provide your own.
+#if defined(XO_ARGS_STATS)
+#include <time.h>
+#define _XO_ARGS_STATS_ADD(context, field, value)                              \
+    (((xo_args_ctx *)(context))->stats.field += (value))
+#define _XO_ARGS_STATS_START()                                                 \
+    uint64_t const _xo_args_stats_start = _xo_args_stats_now_ns()
+#define _XO_ARGS_STATS_STOP(context, field)                                    \
+    _XO_ARGS_STATS_ADD(                                                        \
+        context, field, _xo_args_stats_now_ns() - _xo_args_stats_start)
+#else
+#define _XO_ARGS_STATS_ADD(context, field, value) ((void)0)
+#define _XO_ARGS_STATS_START() ((void)0)
+#define _XO_ARGS_STATS_STOP(context, field) ((void)0)
+#endif
+
+// How deeply response files may refer to other response files.
+#if !defined(XO_ARGS_RESPONSE_FILE_MAX_DEPTH)
+#define XO_ARGS_RESPONSE_FILE_MAX_DEPTH 16
+#endif
+
 #define XO_ARGS_XSTR(a) XO_ARGS_STR(a)
 #define XO_ARGS_STR(a) #a
 
+// Returned by index lookups that find nothing.
+#define XO_ARGS_NO_INDEX ((size_t)-1)
+
+// Every XO_ARGS_TYPE_* flag.
+#define _XO_ARGS_ALL_TYPES                                                     \
+    (XO_ARGS_TYPE_STRING | XO_ARGS_TYPE_SWITCH | XO_ARGS_TYPE_BOOL             \
+     | XO_ARGS_TYPE_INT | XO_ARGS_TYPE_DOUBLE | XO_ARGS_TYPE_BOOL_ARRAY        \
+     | XO_ARGS_TYPE_INT_ARRAY | XO_ARGS_TYPE_DOUBLE_ARRAY                      \
+     | XO_ARGS_TYPE_STRING_ARRAY)
+
 #if !defined(XO_ARGS_ASSERT)
 #include <assert.h>
 #define XO_ARGS_ASSERT(condition, message)                                     \
@@ -320,8 +904,16 @@ struct xo_args_arg
     // The flags tracked so far.
     XO_ARGS_ARG_FLAG flags;
 
+    // The index of this argument in xo_args_ctx::args.
+    size_t position;
+
     // has_value is unset until parsed
     bool has_value;
+
+    // Storage owned by the caller that receives the value (see
+    // xo_args_bind_int etc.). binding_count is only used by arrays.
+    void * binding;
+    size_t * binding_count;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -331,10 +923,14 @@ typedef struct _xo_args_arg_single
     union
     {
         bool _bool;
-        char * _string;
+        char const * _string;
         int64_t _int;
         double _double;
     } value;
+    // The copy of a string value. It is reused when the context is parsed
+    // again after xo_args_reset_values.
+    char * string_copy;
+    size_t string_copy_reserved;
 } _xo_args_arg_single;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -344,13 +940,89 @@ typedef struct _xo_args_arg_array
     void ** array;
     size_t array_reserved;
     size_t array_size;
+    // The number of values to allocate room for up front. See
+    // xo_args_set_capacity_hint.
+    size_t capacity_hint;
+    // The most values the tokens being submitted can give this array. See
+    // _xo_args_presize_arrays.
+    size_t presize_values;
+    // Receives values instead of the array. See xo_args_set_value_callback.
+    xo_args_value_fn value_fn;
+    void * value_fn_user_data;
 } _xo_args_arg_array;
 
+////////////////////////////////////////////////////////////////////////////////
+// String array values are copied back to back (each with a null terminator)
+// into one blob with a parallel table of offsets and lengths. base.array holds
+// char pointers into the blob and is rebased whenever the blob moves. With
+// XO_ARGS_CTX_BORROW_ARGV nothing is copied: base.array points into argv and
+// the blob and tables are unused.
+typedef struct _xo_args_arg_string_array
+{
+    _xo_args_arg_array base;
+    char * blob;
+    size_t blob_reserved;
+    size_t blob_size;
+    size_t * offsets;
+    size_t * lengths;
+    size_t table_reserved; // elements allocated in offsets and lengths
+    size_t presize_bytes;  // like base.presize_values but for the blob
+} _xo_args_arg_string_array;
+
+////////////////////////////////////////////////////////////////////////////////
+// One user-input token with metadata computed once up front by
+// xo_args_submit so matching never needs to rescan its bytes.
+typedef struct _xo_args_token
+{
+    char const * str;
+    size_t length;
+    // The index of the first '=' in str or length if there is none.
+    size_t assign;
+    // The number of leading '-' characters: 0, 1 or 2 (meaning 2 or more).
+    unsigned char dashes;
+    // str points into a response file kept by the context so string values
+    // can use it without making a copy.
+    bool from_response_file;
+} _xo_args_token;
+
+////////////////////////////////////////////////////////////////////////////////
+// Memory holding the tokens of response files: either a mapped file or a
+// tracked allocation (a file read with stdio, or a token that had to be
+// copied). It is released by xo_args_reset_values and xo_args_destroy_ctx.
+typedef struct _xo_args_response_file
+{
+    struct _xo_args_response_file * next;
+    void * data;
+    size_t size;
+    bool mapped;
+} _xo_args_response_file;
+
+////////////////////////////////////////////////////////////////////////////////
+// A single slot in the name index. Names and short names share one
+// open-addressed table; is_short tells them apart. arg_slot is the index of the
+// argument in xo_args_ctx::args plus one so a zeroed slot reads as empty.
+typedef struct _xo_args_index_slot
+{
+    size_t hash;
+    size_t arg_slot;
+    bool is_short;
+} _xo_args_index_slot;
+
+////////////////////////////////////////////////////////////////////////////////
+// A chunk of arena memory. The usable bytes follow this header.
+typedef struct _xo_args_arena_chunk
+{
+    struct _xo_args_arena_chunk * next;
+    size_t reserved; // usable bytes in this chunk
+    size_t size;     // bytes handed out so far
+} _xo_args_arena_chunk;
+
 ////////////////////////////////////////////////////////////////////////////////
 struct xo_args_ctx
 {
     xo_argc_t argc;
     xo_argv_t argv;
+    XO_ARGS_CTX_FLAG flags;
     xo_args_alloc_fn alloc;
     xo_args_realloc_fn realloc;
     xo_args_free_fn free;
@@ -364,18 +1036,75 @@ struct xo_args_ctx
     char const * app_documentation;
     size_t app_documentation_length;
 
-    // A list of all allocations to free later in xo_args_cleanup
+    // A list of all allocations to free later in xo_args_cleanup. Each entry
+    // points at an _xo_args_alloc_header that stores the entry's own index.
     void ** allocations;
     size_t allocations_reserved; // number of allocated elements in allocations
     size_t allocations_size;     // actual size
 
+    // With XO_ARGS_CTX_ARENA: the chunks that tracked allocations are carved
+    // from. The first chunk is the one currently being filled. allocations is
+    // unused in this mode.
+    _xo_args_arena_chunk * arena;
+    size_t arena_chunk_size;
+
+    size_t value_threads; // see xo_args_ctx_options
+
     // A list of arguments. This is not a tracked allocation but all
     // arguments in this list are tracked allocations.
     xo_args_arg ** args;
     size_t args_reserved;
     size_t args_size;
 
-    bool submitted;
+    // argv preprocessed by xo_args_submit. Without response files tokens[i]
+    // describes argv[i], otherwise each "@path" is replaced by the tokens of
+    // the file at path.
+    _xo_args_token * tokens;
+    size_t tokens_reserved;
+    size_t tokens_size;
+
+    // With XO_ARGS_CTX_RESPONSE_FILES: the memory of every response file
+    // loaded since the last reset.
+    _xo_args_response_file * response_files;
+
+    // A hash index of every name and short name in args. This is built by
+    // xo_args_submit once all arguments are declared.
+    _xo_args_index_slot * index;
+    size_t index_reserved; // always a power of two (or 0 before submit)
+    size_t indexed_args;   // args_size when the index was built
+
+    // With XO_ARGS_CTX_CACHE_HELP: the help text as rendered by
+    // xo_args_submit. help_text is NULL when there is no valid cache.
+    char * help_text;
+    size_t help_text_length;
+
+    // The built-in --help and --version arguments (version_arg is NULL without
+    // an app_version).
+    xo_args_arg * help_arg;
+    xo_args_arg * version_arg;
+
+    // Parsing state kept between tokens so arguments can be fed one at a time.
+    // stream_arg is the argument the next token may be a value of, stream_short
+    // is true if the user named it with its short name and stream_values is the
+    // number of values it has been given since.
+    xo_args_arg * stream_arg;
+    size_t stream_values;
+    bool stream_short;
+
+    bool parse_started;  // xo_args_submit or xo_args_feed has begun parsing
+    bool parse_failed;   // a token was invalid
+    bool parse_finished; // xo_args_submit or xo_args_finish has been called
+
+    // A context is either a frozen schema, created from one (schema is not
+    // NULL) or neither. A context created from a schema borrows its index and
+    // help text and args holds copies of the schema's arguments.
+    xo_args_ctx const * schema;
+    bool frozen;
+
+#if defined(XO_ARGS_STATS)
+    xo_args_stats stats;
+    size_t tracked_bytes; // bytes in tracked allocations right now
+#endif
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -406,1587 +1135,4988 @@ typedef struct _xo_args_arg_match
 
 ////////////////////////////////////////////////////////////////////////////////
 bool _xo_args_arg_matches_input(xo_args_arg const * const arg,
-                                char const * const str,
+                                _xo_args_token const * const token,
                                 _xo_args_arg_match * out_match)
 {
-    size_t const str_len = strlen(str);
-    if (0 == str_len)
+    char const * const str = token->str;
+    size_t const str_len = token->length;
+    if (0 == token->dashes)
     {
         return false;
     }
-    if ('-' == str[0])
+
+    if ((2 == token->dashes) && (str_len > 2)
+        && (str_len - 2 >= arg->name_length)
+        && (0 == memcmp(&str[2], arg->name, arg->name_length)))
     {
-        if ((str_len > 2) && ('-' == str[1])
-            && (0 == strncmp(&str[2], arg->name, arg->name_length)))
+        if (str_len - 2 == arg->name_length)
         {
-            if (str_len - 2 == arg->name_length)
+            if (NULL != out_match)
             {
-                if (NULL != out_match)
-                {
-                    out_match->match_type = _XO_ARGS_ARG_MATCH_TYPE_NAME;
-                    out_match->matched_name = arg->name;
-                    out_match->matched_name_length = arg->name_length;
-                }
-                return true;
+                out_match->match_type = _XO_ARGS_ARG_MATCH_TYPE_NAME;
+                out_match->matched_name = arg->name;
+                out_match->matched_name_length = arg->name_length;
             }
-            if ('=' == str[arg->name_length + 2])
+            return true;
+        }
+        if ('=' == str[arg->name_length + 2])
+        {
+            if (NULL != out_match)
             {
-                if (NULL != out_match)
-                {
-                    out_match->match_type = _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME;
-                    out_match->matched_name = arg->name;
-                    out_match->matched_name_length = arg->name_length;
-                }
-                return true;
+                out_match->match_type = _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME;
+                out_match->matched_name = arg->name;
+                out_match->matched_name_length = arg->name_length;
             }
-            return false;
+            return true;
         }
+        return false;
+    }
 
-        if ((NULL != arg->short_name)
-            && (0 == strncmp(&str[1], arg->short_name, arg->short_name_length)))
+    if ((NULL != arg->short_name) && (str_len - 1 >= arg->short_name_length)
+        && (0 == memcmp(&str[1], arg->short_name, arg->short_name_length)))
+    {
+        if (str_len - 1 == arg->short_name_length)
         {
-            if (str_len - 1 == arg->short_name_length)
+            if (NULL != out_match)
             {
-                if (NULL != out_match)
-                {
-                    out_match->match_type = _XO_ARGS_ARG_MATCH_TYPE_SHORT_NAME;
-                    out_match->matched_name = arg->short_name;
-                    out_match->matched_name_length = arg->short_name_length;
-                }
-                return true;
+                out_match->match_type = _XO_ARGS_ARG_MATCH_TYPE_SHORT_NAME;
+                out_match->matched_name = arg->short_name;
+                out_match->matched_name_length = arg->short_name_length;
             }
-            if ('=' == str[arg->short_name_length + 1])
+            return true;
+        }
+        if ('=' == str[arg->short_name_length + 1])
+        {
+            if (NULL != out_match)
             {
-                if (NULL != out_match)
-                {
-                    out_match->match_type =
-                        _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_SHORT_NAME;
-                    out_match->matched_name = arg->short_name;
-                    out_match->matched_name_length = arg->short_name_length;
-                }
-                return true;
+                out_match->match_type =
+                    _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_SHORT_NAME;
+                out_match->matched_name = arg->short_name;
+                out_match->matched_name_length = arg->short_name_length;
             }
-            return false;
+            return true;
         }
+        return false;
     }
     return false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void * _xo_args_tracked_alloc(xo_args_ctx * const context, size_t const size)
+// Every tracked allocation is prefixed with a header recording its slot in
+// xo_args_ctx::allocations so realloc and free find it without searching. The
+// union keeps the memory that follows the header aligned for any value type.
+typedef union _xo_args_alloc_header
 {
-    if (context->allocations_reserved == context->allocations_size)
-    {
-        context->allocations_reserved *= 2;
-        context->allocations = (void **)context->realloc(
-            context->allocations,
-            context->allocations_reserved * sizeof(void *));
-    }
-    void * const mem = context->alloc(size);
-    context->allocations[context->allocations_size++] = mem;
-    return mem;
+    size_t slot;
+#if defined(XO_ARGS_STATS)
+    // With XO_ARGS_STATS the requested size follows the slot so the bytes
+    // given back by realloc and free are known.
+    size_t slot_and_size[2];
+#endif
+    long double _align_long_double;
+    void * _align_pointer;
+    int64_t _align_int64;
+} _xo_args_alloc_header;
+
+////////////////////////////////////////////////////////////////////////////////
+// Rounds size up to the alignment of _xo_args_alloc_header which is suitable
+// for any value type.
+size_t _xo_args_align(size_t const size)
+{
+    size_t const alignment = sizeof(_xo_args_alloc_header);
+    return (size + alignment - 1) / alignment * alignment;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void * _xo_args_tracked_realloc(xo_args_ctx * const context,
-                                void * const mem,
-                                size_t const size)
+// The first usable byte of an arena chunk.
+char * _xo_args_arena_chunk_data(_xo_args_arena_chunk * const chunk)
 {
-    for (size_t i = 0; i < context->allocations_size; ++i)
+    return (char *)chunk + _xo_args_align(sizeof(_xo_args_arena_chunk));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Arena allocations are prefixed with an _xo_args_alloc_header too but the
+// header stores the allocation size so that realloc knows how much to copy.
+void * _xo_args_arena_alloc(xo_args_ctx * const context, size_t const size)
+{
+    size_t const needed = sizeof(_xo_args_alloc_header) + _xo_args_align(size);
+    _xo_args_arena_chunk * chunk = context->arena;
+    if (NULL == chunk || chunk->size + needed > chunk->reserved)
     {
-        if (mem == context->allocations[i])
+        size_t const reserved =
+            needed > context->arena_chunk_size ? needed
+                                               : context->arena_chunk_size;
+        chunk = (_xo_args_arena_chunk *)context->alloc(
+            _xo_args_align(sizeof(_xo_args_arena_chunk)) + reserved);
+        chunk->reserved = reserved;
+        chunk->size = 0;
+
+        // An oversized allocation gets a chunk of its own which we file
+        // behind the current chunk so the space left in it isn't wasted.
+        if (NULL != context->arena && needed > context->arena_chunk_size)
         {
-            context->allocations[i] = context->realloc(mem, size);
-            return context->allocations[i];
+            chunk->next = context->arena->next;
+            context->arena->next = chunk;
+        }
+        else
+        {
+            chunk->next = context->arena;
+            context->arena = chunk;
         }
     }
-    XO_ARGS_ASSERT(false, "Failed to find allocation for realloc");
-    return NULL;
+
+    _xo_args_alloc_header * const header =
+        (_xo_args_alloc_header *)(_xo_args_arena_chunk_data(chunk)
+                                  + chunk->size);
+    header->slot = size;
+    chunk->size += needed;
+    return header + 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void _xo_args_tracked_free(xo_args_ctx * const context, void * const mem)
+// True if mem is the most recent allocation in the current arena chunk which
+// means it can grow or shrink in place.
+bool _xo_args_arena_is_last(xo_args_ctx const * const context,
+                            void * const mem)
 {
-    // We will free the memory and stop tracking it, but we do this with a
-    // last-swap this lets us avoid shuffling elements down since order of our
-    // tracked allocation list is not important to us.
-    for (size_t i = 0; i < context->allocations_size; ++i)
+    _xo_args_arena_chunk * const chunk = context->arena;
+    _xo_args_alloc_header const * const header =
+        (_xo_args_alloc_header const *)mem - 1;
+    return (NULL != chunk)
+           && ((char *)mem + _xo_args_align(header->slot)
+               == _xo_args_arena_chunk_data(chunk) + chunk->size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void * _xo_args_arena_realloc(xo_args_ctx * const context,
+                              void * const mem,
+                              size_t const size)
+{
+    _xo_args_alloc_header * const header = (_xo_args_alloc_header *)mem - 1;
+    size_t const old_size = header->slot;
+    if (_xo_args_arena_is_last(context, mem))
     {
-        if (context->allocations[i] == mem)
+        _xo_args_arena_chunk * const chunk = context->arena;
+        size_t const old_aligned = _xo_args_align(old_size);
+        size_t const new_aligned = _xo_args_align(size);
+        if (chunk->size - old_aligned + new_aligned <= chunk->reserved)
         {
-            context->free(mem);
-            // decrement the size and now allocations_size is the previous last
-            // element index
-            --context->allocations_size;
-
-            if (i != context->allocations_size)
-            {
-                context->allocations[i] =
-                    context->allocations[context->allocations_size];
-            }
-            return;
+            chunk->size = chunk->size - old_aligned + new_aligned;
+            header->slot = size;
+            return mem;
         }
     }
+    // The old memory is abandoned in its chunk until the context is destroyed.
+    void * const new_mem = _xo_args_arena_alloc(context, size);
+    memcpy(new_mem, mem, old_size < size ? old_size : size);
+    return new_mem;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void _xo_args_arg_array_init(xo_args_ctx * const context,
-                             _xo_args_arg_array * const array,
-                             size_t const value_size)
+void _xo_args_arena_free(xo_args_ctx * const context, void * const mem)
 {
-    array->array_reserved = 2;
-    array->array_size = 0;
-    array->array = (void **)_xo_args_tracked_alloc(
-        context, value_size * array->array_reserved);
+    // Only the most recent allocation can be given back; anything else is
+    // released with the rest of the arena.
+    if (_xo_args_arena_is_last(context, mem))
+    {
+        _xo_args_alloc_header const * const header =
+            (_xo_args_alloc_header const *)mem - 1;
+        context->arena->size -=
+            sizeof(_xo_args_alloc_header) + _xo_args_align(header->slot);
+    }
 }
 
+#if defined(XO_ARGS_STATS)
 ////////////////////////////////////////////////////////////////////////////////
-void _xo_args_arg_array_push(xo_args_ctx * const context,
-                             _xo_args_arg_array * const array,
-                             void * const value,
-                             size_t const value_size)
+uint64_t _xo_args_stats_now_ns(void)
 {
-    if (0 == array->array_reserved)
+#if defined(XO_ARGS_STATS_CLOCK_NS)
+    return XO_ARGS_STATS_CLOCK_NS;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#elif (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L)               \
+    || (defined(_MSC_VER) && _MSC_VER >= 1900)
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#else
+    return (uint64_t)((double)clock() * (1000000000.0 / CLOCKS_PER_SEC));
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The size requested for a tracked allocation.
+size_t _xo_args_stats_size(xo_args_ctx const * const context,
+                           void * const mem)
+{
+    _xo_args_alloc_header const * const header =
+        (_xo_args_alloc_header const *)mem - 1;
+    return (context->flags & XO_ARGS_CTX_ARENA) ? header->slot
+                                                 : header->slot_and_size[1];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Records that a tracked allocation of old_size bytes became size bytes.
+void _xo_args_stats_track(xo_args_ctx * const context,
+                          size_t const old_size,
+                          size_t const size)
+{
+    context->tracked_bytes = context->tracked_bytes - old_size + size;
+    if (context->tracked_bytes > context->stats.peak_tracked_bytes)
     {
-        _xo_args_arg_array_init(context, array, value_size);
+        context->stats.peak_tracked_bytes = context->tracked_bytes;
     }
+    context->stats.bytes_requested += size;
+}
+#endif
 
-    if (array->array_reserved == array->array_size)
+////////////////////////////////////////////////////////////////////////////////
+void * _xo_args_tracked_alloc(xo_args_ctx * const context, size_t const size)
+{
+#if defined(XO_ARGS_STATS)
+    ++context->stats.allocations;
+    _xo_args_stats_track(context, 0, size);
+#endif
+    if (context->flags & XO_ARGS_CTX_ARENA)
     {
-        array->array_reserved *= 2;
-        array->array = (void **)_xo_args_tracked_realloc(
-            context, array->array, array->array_reserved * value_size);
+        return _xo_args_arena_alloc(context, size);
     }
-    memcpy(((char *)array->array) + (value_size * array->array_size++),
-           value,
-           value_size);
+    if (context->allocations_reserved == context->allocations_size)
+    {
+        context->allocations_reserved *= 2;
+        context->allocations = (void **)context->realloc(
+            context->allocations,
+            context->allocations_reserved * sizeof(void *));
+    }
+    _xo_args_alloc_header * const header = (_xo_args_alloc_header *)
+        context->alloc(sizeof(_xo_args_alloc_header) + size);
+    header->slot = context->allocations_size;
+#if defined(XO_ARGS_STATS)
+    header->slot_and_size[1] = size;
+#endif
+    context->allocations[context->allocations_size++] = header;
+    return header + 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// The basename of a path is the filename with no path or extension(s)
-// Examples:
-//      /a/b/c.e -> c
-//      /a/b/c -> c
-//      /a/b/c.e.f -> c
-//      /a/b/c..f -> c
-//      /a/b/c.. -> c
-//      /a/b/c/ -> c
-//      / ->
-//      /a/b/c// ->
-//
-// This function returns the basename of path newly allocated with the context's
-// alloc function.
-//
-// Example usage:
-//      char const *const foo = "a/b/ccc.e";
-//      size_t const basenameLen = _xo_args_basename(foo, NULL);
-//      char const * bar = malloc(basenameLen+1);
-//      _xo_args_basename(foo, bar);
-//      printf("foo: %s\nbar: %s\n", foo, bar); // prints "foo: a/b/ccc.e\nbar:
-//      ccc\n" free(bar);
-char const * _xo_args_basename(xo_args_ctx * const context,
-                               char const * const path)
+void * _xo_args_tracked_realloc(xo_args_ctx * const context,
+                                void * const mem,
+                                size_t const size)
 {
-    if (NULL == path)
+#if defined(XO_ARGS_STATS)
+    ++context->stats.reallocations;
+    _xo_args_stats_track(context, _xo_args_stats_size(context, mem), size);
+#endif
+    if (context->flags & XO_ARGS_CTX_ARENA)
     {
-        return NULL;
+        return _xo_args_arena_realloc(context, mem, size);
     }
-
-    size_t const path_len = strlen(path);
-    if (0 == path_len)
+    _xo_args_alloc_header * const header = (_xo_args_alloc_header *)mem - 1;
+    size_t const slot = header->slot;
+    if (slot >= context->allocations_size
+        || header != context->allocations[slot])
     {
+        XO_ARGS_ASSERT(false, "Failed to find allocation for realloc");
         return NULL;
     }
+    _xo_args_alloc_header * const new_header =
+        (_xo_args_alloc_header *)context->realloc(
+            header, sizeof(_xo_args_alloc_header) + size);
+#if defined(XO_ARGS_STATS)
+    new_header->slot_and_size[1] = size;
+#endif
+    context->allocations[slot] = new_header;
+    return new_header + 1;
+}
 
-    char const * const end = path + path_len;
-    char const * it = end;
-    char const * basename_start = path;
-    while (it != path)
+////////////////////////////////////////////////////////////////////////////////
+void _xo_args_tracked_free(xo_args_ctx * const context, void * const mem)
+{
+#if defined(XO_ARGS_STATS)
+    context->tracked_bytes -= _xo_args_stats_size(context, mem);
+#endif
+    if (context->flags & XO_ARGS_CTX_ARENA)
     {
-        bool is_path_sep = false;
-        for (size_t i = 0; i < sizeof(g_xo_args_path_separators) - 1; ++i)
-        {
-            is_path_sep = is_path_sep || *it == g_xo_args_path_separators[i];
-        }
-
-        if (is_path_sep)
-        {
-            // The min is to handle the edge case where the last character is a
-            // path sep we don't accidentally want to advance past the end.
-            basename_start = min(it + 1, end);
-            break;
-        }
-        --it;
+        _xo_args_arena_free(context, mem);
+        return;
     }
-    it = basename_start;
-    char const * basename_end = basename_start;
-    while (it != end)
+    _xo_args_alloc_header * const header = (_xo_args_alloc_header *)mem - 1;
+    size_t const slot = header->slot;
+    if (slot >= context->allocations_size
+        || header != context->allocations[slot])
     {
-        if (*it == '.')
-        {
-            break;
-        }
-        basename_end = it;
-        ++it;
+        XO_ARGS_ASSERT(false, "Failed to find allocation for free");
+        return;
     }
+    context->free(header);
 
-    // both basename_start and basename_end are inclusive so we need to add 1
-    //      "example"
-    //       ^     ^
-    //       |     basename_end
-    //       basename_start
-    // basename_end - basename_start == 6
-    // strlen("example") == 7
-    size_t const basename_length = (basename_end - basename_start) + 1;
-    if (basename_length >= 1)
+    // We stop tracking the memory with a last-swap. This lets us avoid
+    // shuffling elements down since order of our tracked allocation list is not
+    // important to us. The moved allocation's header must learn its new slot.
+    --context->allocations_size;
+    if (slot != context->allocations_size)
     {
-        char * buff =
-            (char *)_xo_args_tracked_alloc(context, basename_length + 1);
-        memcpy(buff, basename_start, basename_length);
-        buff[basename_length] = '\0';
-        return buff;
+        context->allocations[slot] =
+            context->allocations[context->allocations_size];
+        ((_xo_args_alloc_header *)context->allocations[slot])->slot = slot;
     }
-    // There is no string to copy.
-    return NULL;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool _xo_isalnum(char const c)
+// FNV-1a over the name bytes. Short names are hashed from a different basis so
+// "--v" and "-v" don't pile up in the same probe sequence.
+size_t _xo_args_hash_name(char const * const name,
+                          size_t const name_length,
+                          bool const is_short)
 {
-    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')
-           || (c >= '0' && c <= '9') || (c == '-');
+    uint64_t hash = is_short ? 0x84222325cbf29ce4ull : 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < name_length; ++i)
+    {
+        hash ^= (unsigned char)name[i];
+        hash *= 0x100000001b3ull;
+    }
+    return (size_t)(hash ^ (hash >> 32));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool _xo_isalnum_str(char const * const start, char const * const end)
+// Adds the name (or short name) of context->args[arg_index] to the index.
+// Returns false without adding it if an argument already in the index has the
+// same name (or short name).
+bool _xo_args_index_insert(xo_args_ctx * const context,
+                           size_t const arg_index,
+                           bool const is_short)
 {
-    char const * const last = (NULL != end ? end : (start + strlen(start))) - 1;
-    char const * curr = start;
-    while (curr != last)
+    xo_args_arg const * const arg = context->args[arg_index];
+    char const * const name = is_short ? arg->short_name : arg->name;
+    size_t const name_length =
+        is_short ? arg->short_name_length : arg->name_length;
+    size_t const hash = _xo_args_hash_name(name, name_length, is_short);
+    size_t const mask = context->index_reserved - 1;
+    size_t i = hash & mask;
+    while (0 != context->index[i].arg_slot)
     {
-        if (false == _xo_isalnum(*curr))
+        _xo_args_index_slot const * const slot = &context->index[i];
+        if (slot->hash == hash && slot->is_short == is_short)
         {
-            return false;
+            xo_args_arg const * const other = context->args[slot->arg_slot - 1];
+            char const * const other_name =
+                is_short ? other->short_name : other->name;
+            if (0 == strcmp(other_name, name))
+            {
+                return false;
+            }
         }
-        ++curr;
+        i = (i + 1) & mask;
     }
+    context->index[i].hash = hash;
+    context->index[i].arg_slot = arg_index + 1;
+    context->index[i].is_short = is_short;
     return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void _xo_print_try_help(xo_args_ctx const * const context)
+// (Re)builds the name index from every declared argument. The table is kept at
+// most half full: each argument contributes up to two keys and we reserve four
+// slots per argument.
+//
+// Returns the index into context->args of the first argument whose name (or
+// short name when out_is_short is set to true) is already taken by an earlier
+// argument or XO_ARGS_NO_INDEX if every name is unique. out_is_short may be
+// NULL.
+size_t _xo_args_index_build(xo_args_ctx * const context,
+                            bool * const out_is_short)
 {
-    context->print("Try: %s --help\n", context->app_name);
-}
+    size_t reserved = 8;
+    while (reserved < context->args_size * 4)
+    {
+        reserved *= 2;
+    }
 
-////////////////////////////////////////////////////////////////////////////////
-void _xo_args_print_arg_help(xo_args_ctx const * const context,
-                             xo_args_arg const * const arg,
-                             size_t const left_column_width)
-{
-    char left_buffer[128] = {0};
-    if (arg->short_name != NULL)
+    if (reserved != context->index_reserved)
     {
-        if ((arg->name_length == arg->short_name_length)
-            && (0 == strcmp(arg->name, arg->short_name)))
+        if (NULL != context->index)
         {
-            if (arg->value_tip_length != 0)
-            {
-                snprintf(left_buffer,
-                         sizeof(left_buffer),
-                         "  -%s %s",
-                         arg->short_name,
-                         arg->value_tip);
-            }
-            else
-            {
-                snprintf(
-                    left_buffer, sizeof(left_buffer), "  -%s", arg->short_name);
-            }
+            _xo_args_tracked_free(context, context->index);
         }
-        else
+        context->index_reserved = reserved;
+        context->index = (_xo_args_index_slot *)_xo_args_tracked_alloc(
+            context, reserved * sizeof(_xo_args_index_slot));
+    }
+    memset(context->index, 0, reserved * sizeof(_xo_args_index_slot));
+
+    for (size_t i = 0; i < context->args_size; ++i)
+    {
+        bool is_short = false;
+        if (_xo_args_index_insert(context, i, false))
         {
-            if (arg->value_tip_length != 0)
-            {
-                snprintf(left_buffer,
-                         sizeof(left_buffer),
-                         "  --%s, -%s %s",
-                         arg->name,
-                         arg->short_name,
-                         arg->value_tip);
-            }
-            else
+            is_short = true;
+            if (NULL == context->args[i]->short_name
+                || _xo_args_index_insert(context, i, true))
             {
-                snprintf(left_buffer,
-                         sizeof(left_buffer),
-                         "  --%s, -%s",
-                         arg->name,
-                         arg->short_name);
+                continue;
             }
         }
+        if (NULL != out_is_short)
+        {
+            *out_is_short = is_short;
+        }
+        return i;
     }
-    else
+    return XO_ARGS_NO_INDEX;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the index into context->args of the argument whose name (or short
+// name) is exactly name[0..name_length) or XO_ARGS_NO_INDEX if there is none.
+size_t _xo_args_index_find(xo_args_ctx const * const context,
+                           char const * const name,
+                           size_t const name_length,
+                           bool const is_short)
+{
+    if (0 == context->index_reserved || 0 == name_length)
     {
-        if (arg->value_tip_length != 0)
+        return XO_ARGS_NO_INDEX;
+    }
+    size_t const hash = _xo_args_hash_name(name, name_length, is_short);
+    size_t const mask = context->index_reserved - 1;
+    for (size_t i = hash & mask; 0 != context->index[i].arg_slot;
+         i = (i + 1) & mask)
+    {
+        _xo_args_index_slot const * const slot = &context->index[i];
+        if (slot->hash != hash || slot->is_short != is_short)
         {
-            snprintf(left_buffer,
-                     sizeof(left_buffer),
-                     "  --%s %s",
-                     arg->name,
-                     arg->value_tip);
+            continue;
         }
-        else
+        xo_args_arg const * const arg = context->args[slot->arg_slot - 1];
+        char const * const arg_name = is_short ? arg->short_name : arg->name;
+        size_t const arg_name_length =
+            is_short ? arg->short_name_length : arg->name_length;
+        if (arg_name_length == name_length
+            && 0 == memcmp(arg_name, name, name_length))
         {
-            snprintf(left_buffer, sizeof(left_buffer), "  --%s", arg->name);
+            return slot->arg_slot - 1;
         }
     }
-
-    size_t const left_buffer_len = strlen(left_buffer);
-    size_t const whitespace_needed = left_buffer_len > left_column_width
-                                         ? 0
-                                         : left_column_width - left_buffer_len;
-    context->print("%s%*s", left_buffer, whitespace_needed, "");
-
-    if (NULL != arg->description)
-    {
-        // todo: wrap after some width
-        context->print(arg->description);
-    }
-    context->print("\n");
+    return XO_ARGS_NO_INDEX;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void xo_args_print_help(xo_args_ctx const * const context)
+// Finds the declared argument matched by a user-input string such as "--foo",
+// "--foo=bar", "-f" or "-f=bar" using the name index.
+//
+// At most two arguments can be candidates for a given input: the one whose
+// name follows "--" and the one whose short name follows "-". Both are checked
+// with _xo_args_arg_matches_input in declaration order so the result is the
+// same as testing every declared argument in turn.
+xo_args_arg * _xo_args_find_arg(xo_args_ctx const * const context,
+                                _xo_args_token const * const token,
+                                _xo_args_arg_match * out_match)
 {
-    if (NULL != context->app_version)
+    if (token->length < 2 || 0 == token->dashes)
     {
-        context->print(
-            "%s version %s\n", context->app_name, context->app_version);
+        return NULL;
     }
-    else
+
+    // Names never contain '=' so the key ends at the first one.
+    char const * const str = token->str;
+    size_t candidates[2] = {XO_ARGS_NO_INDEX, XO_ARGS_NO_INDEX};
+    if (token->length > 2 && 2 == token->dashes)
     {
-        context->print("%s\n", context->app_name);
+        candidates[0] =
+            _xo_args_index_find(context, &str[2], token->assign - 2, false);
     }
+    candidates[1] =
+        _xo_args_index_find(context, &str[1], token->assign - 1, true);
 
-    context->print("Usage: %s", context->app_name);
-
-    bool any_required = false;
-    for (size_t i = 0; i < context->args_size; ++i)
+    if (candidates[1] < candidates[0])
     {
-        xo_args_arg const * const arg = context->args[i];
-        if (arg->flags & XO_ARGS_ARG_REQUIRED)
-        {
-            context->print(" --%s", arg->name);
-            any_required = true;
-        }
+        size_t const temp = candidates[0];
+        candidates[0] = candidates[1];
+        candidates[1] = temp;
     }
 
-    bool any_optional = false;
-    for (size_t i = 0; i < context->args_size; ++i)
+    for (size_t i = 0; i < 2 && XO_ARGS_NO_INDEX != candidates[i]; ++i)
     {
-        xo_args_arg const * const arg = context->args[i];
-        if (false == !!(arg->flags & XO_ARGS_ARG_REQUIRED))
+        xo_args_arg * const arg = context->args[candidates[i]];
+        _XO_ARGS_STATS_ADD(context, match_attempts, 1);
+        if (_xo_args_arg_matches_input(arg, token, out_match))
         {
-            any_optional = true;
+            return arg;
         }
     }
+    return NULL;
+}
 
-    if (any_optional)
+////////////////////////////////////////////////////////////////////////////////
+// True if input names a declared argument, which ends the run of values being
+// consumed by an array argument. Anything not starting with '-' is rejected
+// before touching the name index.
+bool _xo_args_ends_array(xo_args_ctx const * const context,
+                         _xo_args_token const * const token)
+{
+    if (0 == token->dashes)
     {
-        context->print(" [OPTIONS]...\n");
+        return false;
     }
+    return NULL != _xo_args_find_arg(context, token, NULL);
+}
 
-    if (NULL != context->app_documentation)
+////////////////////////////////////////////////////////////////////////////////
+// Computes the _xo_args_token metadata for a null terminated string in a
+// single pass over its bytes.
+void _xo_args_token_init(_xo_args_token * const token, char const * const str)
+{
+    token->str = str;
+    token->from_response_file = false;
+    token->dashes = 0;
+    while (token->dashes < 2 && '-' == str[token->dashes])
     {
-        context->print("%s\n", context->app_documentation);
+        ++token->dashes;
     }
-
-    size_t left_column_width = 0;
-    for (size_t i = 0; i < context->args_size; ++i)
+    size_t i = token->dashes;
+    while ('\0' != str[i] && '=' != str[i])
     {
-        xo_args_arg const * const arg = context->args[i];
-        // 8 for an indent of 2 spaces, "--" before the name and a buffer of 4
-        // after everything
-        size_t arg_column_space_needed = 8;
-        arg_column_space_needed += arg->name_length;
-        arg_column_space_needed +=
-            (arg->value_tip_length != 0) ? arg->value_tip_length + 1 : 0;
+        ++i;
+    }
+    token->assign = i;
+    while ('\0' != str[i])
+    {
+        ++i;
+    }
+    token->length = i;
+    if ('\0' == str[token->assign])
+    {
+        token->assign = token->length;
+    }
+}
 
-        if (NULL != arg->short_name)
-        {
-            // As a special case if the name and short name are the same:
-            // we just print the short name.
-            if ((arg->name_length == arg->short_name_length)
-                && (0 == strcmp(arg->short_name, arg->name)))
-            {
-                arg_column_space_needed = 7;
-                arg_column_space_needed += arg->short_name_length;
-                arg_column_space_needed += (arg->value_tip_length != 0)
-                                               ? arg->value_tip_length + 1
-                                               : 0;
-            }
-            else
-            {
-                // 2 for ", " between the name and short name
-                arg_column_space_needed += 2 + arg->short_name_length;
-            }
-        }
-        left_column_width = (left_column_width < arg_column_space_needed)
-                                ? arg_column_space_needed
-                                : left_column_width;
+////////////////////////////////////////////////////////////////////////////////
+// Appends an uninitialized token to context->tokens and returns it.
+_xo_args_token * _xo_args_push_token(xo_args_ctx * const context)
+{
+    if (context->tokens_size == context->tokens_reserved)
+    {
+        size_t const reserved =
+            0 == context->tokens_reserved ? 16 : context->tokens_reserved * 2;
+        size_t const bytes = reserved * sizeof(_xo_args_token);
+        context->tokens =
+            (_xo_args_token *)(NULL == context->tokens
+                                   ? _xo_args_tracked_alloc(context, bytes)
+                                   : _xo_args_tracked_realloc(
+                                         context, context->tokens, bytes));
+        context->tokens_reserved = reserved;
     }
+    return &context->tokens[context->tokens_size++];
+}
 
-    if (any_required)
+////////////////////////////////////////////////////////////////////////////////
+// Adds memory holding response file tokens to context->response_files.
+void _xo_args_keep_response_memory(xo_args_ctx * const context,
+                                   void * const data,
+                                   size_t const size,
+                                   bool const mapped)
+{
+    _xo_args_response_file * const file =
+        (_xo_args_response_file *)_xo_args_tracked_alloc(
+            context, sizeof(_xo_args_response_file));
+    file->data = data;
+    file->size = size;
+    file->mapped = mapped;
+    file->next = context->response_files;
+    context->response_files = file;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Unmaps or frees the memory of every response file loaded so far.
+void _xo_args_release_response_files(xo_args_ctx * const context)
+{
+    _xo_args_response_file * file = context->response_files;
+    while (NULL != file)
     {
-        if (any_optional)
+        _xo_args_response_file * const next = file->next;
+#if defined(_XO_ARGS_MMAP)
+        if (file->mapped)
         {
-            context->print("REQUIRED ARGUMENTS:\n");
+            munmap(file->data, file->size);
         }
-        for (size_t i = 0; i < context->args_size; ++i)
+        else
+#endif // defined(_XO_ARGS_MMAP)
         {
-            xo_args_arg const * const arg = context->args[i];
-            if (arg->flags & XO_ARGS_ARG_REQUIRED)
-            {
-                _xo_args_print_arg_help(context, arg, left_column_width);
-            }
+            _xo_args_tracked_free(context, file->data);
         }
+        _xo_args_tracked_free(context, file);
+        file = next;
     }
+    context->response_files = NULL;
+}
 
-    if (any_optional)
+////////////////////////////////////////////////////////////////////////////////
+// Loads the response file at path into writable memory that the context keeps
+// until it is destroyed. out_capacity is the number of writable bytes at
+// out_data, which may be more than out_size but never less.
+//
+// Returns false if the file could not be read.
+bool _xo_args_load_response_file(xo_args_ctx * const context,
+                                 char const * const path,
+                                 char ** const out_data,
+                                 size_t * const out_size,
+                                 size_t * const out_capacity)
+{
+#if defined(_XO_ARGS_MMAP)
+    // A private mapping is copy-on-write: tokenizing it in place never changes
+    // the file itself. Anything that is not a regular file (pipes, devices)
+    // falls through to stdio.
+    int const fd = open(path, O_RDONLY);
+    if (fd < 0)
     {
-        if (any_required)
+        return false;
+    }
+    struct stat file_stat;
+    if (0 == fstat(fd, &file_stat) && S_ISREG(file_stat.st_mode))
+    {
+        size_t const size = (size_t)file_stat.st_size;
+        if (0 == size)
         {
-            context->print("OPTIONAL ARGUMENTS:\n");
+            close(fd);
+            *out_data = NULL;
+            *out_size = 0;
+            *out_capacity = 0;
+            return true;
         }
-        for (size_t i = 0; i < context->args_size; ++i)
+        void * const mapping =
+            mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (MAP_FAILED == mapping)
         {
-            xo_args_arg const * const arg = context->args[i];
-            if (XO_ARGS_ARG_REQUIRED != (arg->flags & XO_ARGS_ARG_REQUIRED))
-            {
-                _xo_args_print_arg_help(context, arg, left_column_width);
-            }
+            return false;
         }
+        _xo_args_keep_response_memory(context, mapping, size, true);
+
+        *out_data = (char *)mapping;
+        *out_size = size;
+        *out_capacity = size;
+        return true;
     }
-}
+    close(fd);
+#endif // defined(_XO_ARGS_MMAP)
 
-////////////////////////////////////////////////////////////////////////////////
-void xo_args_print_version(xo_args_ctx const * const context)
-{
-    if (NULL != context->app_version)
+    FILE * const file = fopen(path, "rb");
+    if (NULL == file)
     {
-        context->print(
-            "%s version %s\n", context->app_name, context->app_version);
+        return false;
     }
-    else
+    size_t reserved = 4096;
+    size_t size = 0;
+    char * data = (char *)_xo_args_tracked_alloc(context, reserved);
+    for (;;)
     {
-        XO_ARGS_ASSERT(NULL != context->app_version,
-                       "No version string was "
-                       "provided but xo_args_print_version was called.");
+        size += fread(&data[size], 1, reserved - size, file);
+        if (size < reserved)
+        {
+            break;
+        }
+        reserved *= 2;
+        data = (char *)_xo_args_tracked_realloc(context, data, reserved);
+    }
+    bool const read_ok = 0 == ferror(file);
+    fclose(file);
+    if (false == read_ok)
+    {
+        _xo_args_tracked_free(context, data);
+        return false;
     }
+    _xo_args_keep_response_memory(context, data, reserved, false);
+    *out_data = data;
+    *out_size = size;
+    *out_capacity = reserved;
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-xo_args_ctx * xo_args_create_ctx_advanced(xo_argc_t const argc,
-                                          xo_argv_t const argv,
-                                          char const * const app_name,
-                                          char const * const app_version,
-                                          char const * const app_documentation,
-                                          xo_args_alloc_fn const alloc_fn,
-                                          xo_args_realloc_fn const realloc_fn,
-                                          xo_args_free_fn const free_fn,
-                                          xo_args_print_fn const print_fn)
+// Whitespace separating the arguments of a response file. Null characters are
+// included since they can not be part of an argument.
+bool _xo_args_is_response_space(char const c)
 {
-    if (argc < 1)
-    {
-        XO_ARGS_ASSERT(argc >= 1, "argc is expected to be >= 1");
-        (print_fn != NULL ? print_fn : printf)("xo-args error: %s argc is"
-                                               " expected to be >= 1 but was"
-                                               "%i\n",
-                                               __func__,
-                                               argc);
-        return NULL;
-    }
+    return ' ' == c || '\t' == c || '\n' == c || '\r' == c || '\v' == c
+           || '\f' == c || '\0' == c;
+}
 
-    if (NULL == argv)
-    {
-        XO_ARGS_ASSERT(NULL != argv, "argv is required");
-        (print_fn != NULL ? print_fn : printf)("xo-args error: %s argv is"
-                                               " required\n",
-                                               __func__);
-        return NULL;
-    }
+////////////////////////////////////////////////////////////////////////////////
+// Defined below. Tokenizing a response file appends tokens with this which
+// recurses into any response files it refers to.
+bool _xo_args_append_token(xo_args_ctx * const context,
+                           char const * const str,
+                           bool const from_response_file,
+                           unsigned const depth);
 
+////////////////////////////////////////////////////////////////////////////////
+// Splits the size bytes of a loaded response file into tokens in place and
+// appends them to context->tokens. The quoting rules are those of GCC response
+// files: whitespace separates tokens, single and double quotes keep whitespace
+// in a token and a backslash escapes the next character (even in quotes).
+//
+// Each token is null terminated by overwriting the whitespace after it. Quotes
+// and backslashes are removed by shifting the rest of the token down over
+// them, so tokens without either are never written to. Only a token that runs
+// up to the end of a mapping with no byte to spare for its terminator is
+// copied.
+bool _xo_args_tokenize_response_file(xo_args_ctx * const context,
+                                     char * const data,
+                                     size_t const size,
+                                     size_t const capacity,
+                                     unsigned const depth)
+{
+    char const * const end = data + size;
+    char * cursor = data;
+    for (;;)
     {
-        bool any_arg_is_null = false;
-        for (int i = 0; i < argc; ++i)
+        while (cursor < end && _xo_args_is_response_space(*cursor))
         {
-            if (NULL == argv[i])
+            ++cursor;
+        }
+        if (cursor == end)
+        {
+            return true;
+        }
+
+        char * const start = cursor;
+        while (cursor < end && !_xo_args_is_response_space(*cursor)
+               && '\'' != *cursor && '"' != *cursor && '\\' != *cursor)
+        {
+            ++cursor;
+        }
+
+        char * out = cursor;
+        char quote = '\0';
+        while (cursor < end)
+        {
+            char const c = *cursor;
+            if ('\\' == c)
             {
-                (print_fn != NULL ? print_fn : printf)("xo-args error: %s"
-                                                       " argv[%i] was NULL\n",
-                                                       __func__,
-                                                       i);
-                any_arg_is_null = true;
+                ++cursor;
+                if (cursor < end)
+                {
+                    *out++ = *cursor;
+                    ++cursor;
+                }
+            }
+            else if ('\0' != quote)
+            {
+                if (c != quote)
+                {
+                    *out++ = c;
+                }
+                else
+                {
+                    quote = '\0';
+                }
+                ++cursor;
+            }
+            else if ('\'' == c || '"' == c)
+            {
+                quote = c;
+                ++cursor;
+            }
+            else if (_xo_args_is_response_space(c))
+            {
+                break;
+            }
+            else
+            {
+                *out++ = c;
+                ++cursor;
             }
         }
 
-        if (any_arg_is_null)
+        char const * str = start;
+        if (out < data + capacity)
         {
-            XO_ARGS_ASSERT(false == any_arg_is_null,
-                           "one or more arguments in argv was null");
-            return NULL;
+            *out = '\0';
+        }
+        else
+        {
+            size_t const length = (size_t)(out - start);
+            char * const copy =
+                (char *)_xo_args_tracked_alloc(context, length + 1);
+            memcpy(copy, start, length);
+            copy[length] = '\0';
+            _xo_args_keep_response_memory(context, copy, length + 1, false);
+            str = copy;
+        }
+        if (false == _xo_args_append_token(context, str, true, depth))
+        {
+            return false;
         }
     }
+}
 
-    xo_args_ctx * const context =
-        (xo_args_ctx *)(NULL != alloc_fn ? alloc_fn(sizeof(xo_args_ctx))
-                                         : malloc(sizeof(xo_args_ctx)));
-
-    context->argc = argc;
-    context->argv = argv;
-    context->print = NULL == print_fn ? printf : print_fn;
-    context->alloc = NULL == alloc_fn ? malloc : alloc_fn;
-    context->realloc = NULL == realloc_fn ? realloc : realloc_fn;
-    context->free = NULL == free_fn ? free : free_fn;
-    context->allocations_size = 0;
-    context->allocations_reserved = 8;
-    context->allocations =
-        (void **)context->alloc(context->allocations_reserved * sizeof(void *));
-    context->submitted = false;
-
-    // Default app_name is the filename parsed from argv[0]
-    if (NULL == app_name)
+////////////////////////////////////////////////////////////////////////////////
+// Appends the token for str to context->tokens. With
+// XO_ARGS_CTX_RESPONSE_FILES a str of the form "@path" is replaced by the
+// tokens of the file at path, or kept as it is if the file can not be read.
+// depth is the number of response files str is nested in.
+//
+// Returns false if response files are nested too deeply.
+bool _xo_args_append_token(xo_args_ctx * const context,
+                           char const * const str,
+                           bool const from_response_file,
+                           unsigned const depth)
+{
+    if ((context->flags & XO_ARGS_CTX_RESPONSE_FILES) && '@' == str[0]
+        && '\0' != str[1])
     {
-        context->app_name = _xo_args_basename(context, argv[0]);
-        if (NULL == context->app_name)
+        if (depth >= XO_ARGS_RESPONSE_FILE_MAX_DEPTH)
         {
-            // We never free app_name directly so this assignment is safe
-            context->app_name = "app";
+            context->print("Error: response files are nested more than "
+                           "%u deep at \"%s\"\n",
+                           (unsigned)XO_ARGS_RESPONSE_FILE_MAX_DEPTH,
+                           str);
+            return false;
+        }
+        char * data = NULL;
+        size_t size = 0;
+        size_t capacity = 0;
+        if (_xo_args_load_response_file(
+                context, &str[1], &data, &size, &capacity))
+        {
+            return _xo_args_tokenize_response_file(
+                context, data, size, capacity, depth + 1);
         }
-
-        context->app_name_length = strlen(context->app_name);
-    }
-    else
-    {
-        size_t const len = strlen(app_name);
-        char * buff = (char *)_xo_args_tracked_alloc(context, len + 1);
-        memcpy(buff, app_name, len + 1);
-        context->app_name = buff;
-        context->app_name_length = len;
     }
+    _xo_args_token * const token = _xo_args_push_token(context);
+    _xo_args_token_init(token, str);
+    token->from_response_file = from_response_file;
+    return true;
+}
 
-    if (NULL == app_version)
+////////////////////////////////////////////////////////////////////////////////
+// Preprocesses argv into context->tokens. Each argv string is scanned exactly
+// once here; everything after works from the cached metadata.
+//
+// Returns false if a response file could not be expanded.
+bool _xo_args_tokenize_argv(xo_args_ctx * const context)
+{
+    size_t const argc = (size_t)context->argc;
+    if (context->tokens_reserved < argc)
     {
-        // A NULL app_version is supported. We just won't print the version in
-        // the help text.
-        context->app_version = NULL;
-        context->app_version_length = 0;
+        if (NULL != context->tokens)
+        {
+            _xo_args_tracked_free(context, context->tokens);
+        }
+        context->tokens = (_xo_args_token *)_xo_args_tracked_alloc(
+            context, argc * sizeof(_xo_args_token));
+        context->tokens_reserved = argc;
     }
-    else
+    context->tokens_size = 0;
+    for (size_t i = 0; i < argc; ++i)
     {
-        size_t const len = strlen(app_version);
-        char * buff = (char *)_xo_args_tracked_alloc(context, len + 1);
-        memcpy(buff, app_version, len + 1);
-        context->app_version = buff;
-        context->app_version_length = 0;
+        // argv[0] is the program and never a response file.
+        if (0 == i || 0 == (context->flags & XO_ARGS_CTX_RESPONSE_FILES))
+        {
+            _xo_args_token_init(_xo_args_push_token(context), context->argv[i]);
+        }
+        else if (false == _xo_args_append_token(
+                              context, context->argv[i], false, 0))
+        {
+            return false;
+        }
     }
+    return true;
+}
 
-    if (NULL == app_documentation)
+////////////////////////////////////////////////////////////////////////////////
+// Allocates room for capacity values, or for the capacity hint of array if it
+// is larger.
+void _xo_args_arg_array_init(xo_args_ctx * const context,
+                             _xo_args_arg_array * const array,
+                             size_t const value_size,
+                             size_t const capacity)
+{
+    array->array_reserved = array->capacity_hint > 2 ? array->capacity_hint : 2;
+    if (array->array_reserved < capacity)
     {
-        // NULL app_documentation is supported. We just won't print the
-        // documentation in the help text.
-        context->app_documentation = NULL;
-        context->app_documentation_length = 0;
+        array->array_reserved = capacity;
     }
-    else
+    array->array_size = 0;
+    array->array = (void **)_xo_args_tracked_alloc(
+        context, value_size * array->array_reserved);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Makes sure array has room for at least capacity values.
+void _xo_args_arg_array_reserve(xo_args_ctx * const context,
+                                _xo_args_arg_array * const array,
+                                size_t const value_size,
+                                size_t const capacity)
+{
+    if (0 == array->array_reserved)
     {
-        size_t const len = strlen(app_documentation);
-        char * buff = (char *)_xo_args_tracked_alloc(context, len + 1);
-        memcpy(buff, app_documentation, len + 1);
-        context->app_documentation = buff;
-        context->app_documentation_length = 0;
+        _xo_args_arg_array_init(context, array, value_size, capacity);
     }
 
-    context->args_size = 0;
-    context->args_reserved = 4;
-    context->args = (xo_args_arg **)_xo_args_tracked_alloc(
-        context, context->args_reserved * sizeof(xo_args_arg *));
-
-    return context;
+    if (array->array_reserved < capacity)
+    {
+        array->array_reserved *= 2;
+        if (array->array_reserved < capacity)
+        {
+            array->array_reserved = capacity;
+        }
+        array->array = (void **)_xo_args_tracked_realloc(
+            context, array->array, array->array_reserved * value_size);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-xo_args_ctx * xo_args_create_ctx(xo_argc_t const argc, xo_argv_t const argv)
+void _xo_args_arg_array_push(xo_args_ctx * const context,
+                             _xo_args_arg_array * const array,
+                             void * const value,
+                             size_t const value_size)
 {
-    return xo_args_create_ctx_advanced(argc,
-                                       argv,
-                                       /*app_name*/ NULL,
-                                       /*app_version*/ NULL,
-                                       /*app_documentation*/ NULL,
-                                       /*alloc_fn*/ NULL,
-                                       /*realloc_fn*/ NULL,
-                                       /*free_fn*/ NULL,
-                                       /*print_fn*/ NULL);
+    _xo_args_arg_array_reserve(
+        context, array, value_size, array->array_size + 1);
+    memcpy(((char *)array->array) + (value_size * array->array_size++),
+           value,
+           value_size);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool _xo_args_try_parse_int(char const * const input, int64_t * out_int)
+// Makes sure the blob of array has room for needed bytes. The strings already
+// in the blob are rebased if it moves.
+void _xo_args_string_array_reserve_blob(xo_args_ctx * const context,
+                                        _xo_args_arg_string_array * const array,
+                                        size_t const needed)
 {
-    // strtoll will discard any leading whitespace.
-    // I would prefer we only accept integers with no leading whitespace so we
-    // can accomplish this by just checking the first character here:
-    if ('\0' == input[0] || isspace(input[0]))
+    if (needed <= array->blob_reserved)
     {
-        return false;
+        return;
     }
-
-    errno = 0;
-    char * end_ptr;
-    long long const long_val = strtoll(input, &end_ptr, 0);
-    int64_t const parsed_val = (int64_t)long_val;
-
-    if (0 != errno || '\0' != *end_ptr || long_val != (long long)parsed_val
-        || input == end_ptr)
+    size_t reserved = 0 == array->blob_reserved ? 64 : array->blob_reserved;
+    while (reserved < needed)
     {
-        return false;
+        reserved *= 2;
+    }
+    char * const old_blob = array->blob;
+    if (NULL == old_blob)
+    {
+        array->blob = (char *)_xo_args_tracked_alloc(context, reserved);
+    }
+    else
+    {
+        array->blob =
+            (char *)_xo_args_tracked_realloc(context, old_blob, reserved);
     }
+    array->blob_reserved = reserved;
 
-    *out_int = parsed_val;
-    return true;
+    if (old_blob != array->blob)
+    {
+        char const ** const strings = (char const **)array->base.array;
+        for (size_t i = 0; i < array->base.array_size; ++i)
+        {
+            strings[i] = array->blob + array->offsets[i];
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool _xo_args_try_parse_bool(char const * const input, bool * out_bool)
+// Makes sure the offset and length tables of array have as many elements as
+// base.array.
+void _xo_args_string_array_reserve_tables(
+    xo_args_ctx * const context,
+    _xo_args_arg_string_array * const array)
 {
-    if ((0 == strcmp(input, "0")) || (0 == strcmp(input, "false"))
-        || (0 == strcmp(input, "False")) || (0 == strcmp(input, "FALSE")))
+    if (array->table_reserved >= array->base.array_reserved)
     {
-        *out_bool = false;
-        return true;
+        return;
     }
-    else if ((0 == strcmp(input, "1")) || (0 == strcmp(input, "true"))
-             || (0 == strcmp(input, "True")) || (0 == strcmp(input, "TRUE")))
+    array->table_reserved = array->base.array_reserved;
+    size_t const table_bytes = array->table_reserved * sizeof(size_t);
+    if (NULL == array->offsets)
     {
-        *out_bool = true;
-        return true;
+        array->offsets = (size_t *)_xo_args_tracked_alloc(context, table_bytes);
+        array->lengths = (size_t *)_xo_args_tracked_alloc(context, table_bytes);
     }
     else
     {
-        return false;
+        array->offsets = (size_t *)_xo_args_tracked_realloc(
+            context, array->offsets, table_bytes);
+        array->lengths = (size_t *)_xo_args_tracked_realloc(
+            context, array->lengths, table_bytes);
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool _xo_args_try_parse_double(char const * const input, double * out_double)
+void _xo_args_string_array_push(xo_args_ctx * const context,
+                                _xo_args_arg_string_array * const array,
+                                char const * const value)
 {
-    // strtod will discard any leading whitespace.
-    // I would prefer we only accept integers with no leading whitespace so we
-    // can accomplish this by just checking the first character here:
-    if ('\0' == input[0] || isspace(input[0]))
+    if (context->flags & XO_ARGS_CTX_BORROW_ARGV)
     {
-        return false;
+        _xo_args_arg_array_push(
+            context, &array->base, (void *)&value, sizeof(char const *));
+        return;
     }
 
-    errno = 0;
-    char * end_ptr;
-    *out_double = strtod(input, &end_ptr);
+    size_t const value_length = strlen(value);
+    size_t const needed = array->blob_size + value_length + 1;
+    _xo_args_string_array_reserve_blob(context, array, needed);
 
-    if (0 != errno || '\0' != *end_ptr || input == end_ptr)
-    {
-        return false;
-    }
+    char * const copy = array->blob + array->blob_size;
+    // +1 here will copy the null terminator from value
+    memcpy(copy, value, value_length + 1);
+    _xo_args_arg_array_push(
+        context, &array->base, (void *)&copy, sizeof(char const *));
+    _xo_args_string_array_reserve_tables(context, array);
 
-    return true;
+    array->offsets[array->base.array_size - 1] = array->blob_size;
+    array->lengths[array->base.array_size - 1] = value_length;
+    array->blob_size = needed;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// A helper to try and parse out a single argument.
+// The basename of a path is the filename with no path or extension(s)
+// Examples:
+//      /a/b/c.e -> c
+//      /a/b/c -> c
+//      /a/b/c.e.f -> c
+//      /a/b/c..f -> c
+//      /a/b/c.. -> c
+//      /a/b/c/ -> c
+//      / ->
+//      /a/b/c// ->
 //
-// argv_index should be the index into argv where the variable name was found
-// it will be automatically advanced as the value of the argument is parsed.
-bool _xo_args_try_parse_arg(xo_args_ctx * const context,
-                            size_t * const argv_index,
-                            xo_args_arg * const arg,
-                            _xo_args_arg_match const * const match)
+// This function returns the basename of path newly allocated with the context's
+// alloc function.
+//
+// Example usage:
+//      char const *const foo = "a/b/ccc.e";
+//      size_t const basenameLen = _xo_args_basename(foo, NULL);
+//      char const * bar = malloc(basenameLen+1);
+//      _xo_args_basename(foo, bar);
+//      printf("foo: %s\nbar: %s\n", foo, bar); // prints "foo: a/b/ccc.e\nbar:
+//      ccc\n" free(bar);
+char const * _xo_args_basename(xo_args_ctx * const context,
+                               char const * const path)
 {
-
-    // Providing an argument multiple times is an error unless
-    // the type of that argument is an array
-    if (arg->has_value && false == _xo_args_arg_flag_is_array(arg->flags))
+    if (NULL == path)
     {
-        // Providing an argument multiple times is only valid for arrays
-        context->print("Error: %s was provided multiple times which is "
-                       "unsupported.\n",
-                       context->argv[*argv_index]);
-        return false;
+        return NULL;
     }
-    if (arg->flags & XO_ARGS_TYPE_STRING)
+
+    size_t const path_len = strlen(path);
+    if (0 == path_len)
     {
-        if (_XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME == match->match_type
-            || _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_SHORT_NAME == match->match_type)
-        {
-            // This is an offset from the start of the user-input argument until
-            // the value begins (after the assignment operator). The value 3
-            // accounts for "--" and "=" in a name based assignment.. The value
-            // 2 accounts for a single "-" and "=" in a short name assignment.
-            size_t const offset =
-                ((_XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME == match->match_type) ? 3
-                                                                            : 2)
-                + match->matched_name_length;
-
-            char const * const argv_value = context->argv[*argv_index];
-            size_t const argv_value_length = strlen(argv_value);
-
-            char * const buff = (char *)_xo_args_tracked_alloc(
-                context, (argv_value_length - offset) + 1);
-            // +1 here will copy the null terminator from argv_value
-            memcpy(buff, &argv_value[offset], argv_value_length - offset + 1);
-            ((_xo_args_arg_single *)arg)->value._string = buff;
-            arg->has_value = true;
-            return true;
+        return NULL;
+    }
+
+    char const * const end = path + path_len;
+    char const * it = end;
+    char const * basename_start = path;
+    while (it != path)
+    {
+        bool is_path_sep = false;
+        for (size_t i = 0; i < sizeof(g_xo_args_path_separators) - 1; ++i)
+        {
+            is_path_sep = is_path_sep || *it == g_xo_args_path_separators[i];
         }
 
-        size_t const next_index = (*argv_index) + 1;
-        if (next_index >= (size_t)context->argc)
+        if (is_path_sep)
         {
-            context->print("Error: No value provided for %s\n",
-                           context->argv[*argv_index]);
-            return false;
+            // The min is to handle the edge case where the last character is a
+            // path sep we don't accidentally want to advance past the end.
+            basename_start = min(it + 1, end);
+            break;
         }
-        char const * const next_value = context->argv[next_index];
-        size_t const next_value_len = strlen(next_value);
-        char * const buff =
-            (char *)_xo_args_tracked_alloc(context, next_value_len + 1);
-        memcpy(buff, next_value, next_value_len + 1);
-        ((_xo_args_arg_single *)arg)->value._string = buff;
-        arg->has_value = true;
-        *argv_index = next_index;
-        return true;
-    }
-    else if (arg->flags & XO_ARGS_TYPE_SWITCH)
-    {
-        // Reminder: value._bool can be uninitialized for switches because when
-        // no value is set it is implicitly false.
-        ((_xo_args_arg_single *)arg)->base.has_value = true;
-        return true;
+        --it;
     }
-    else if (arg->flags & XO_ARGS_TYPE_BOOL)
+    it = basename_start;
+    char const * basename_end = basename_start;
+    while (it != end)
     {
-        if (_XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME == match->match_type
-            || _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_SHORT_NAME == match->match_type)
+        if (*it == '.')
         {
-            // This is an offset from the start of the user-input argument until
-            // the value begins (after the assignment operator). The value 3
-            // accounts for "--" and "=" in a name based assignment.. The value
-            // 2 accounts for a single "-" and "=" in a short name assignment.
-            size_t const offset =
-                ((_XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME == match->match_type) ? 3
-                                                                            : 2)
-                + match->matched_name_length;
-
-            char const * const argv_value = context->argv[*argv_index];
+            break;
+        }
+        basename_end = it;
+        ++it;
+    }
 
-            if (_xo_args_try_parse_bool(
-                    &argv_value[offset],
-                    &((_xo_args_arg_single *)arg)->value._bool))
-            {
-                arg->has_value = true;
-                return true;
-            }
+    // both basename_start and basename_end are inclusive so we need to add 1
+    //      "example"
+    //       ^     ^
+    //       |     basename_end
+    //       basename_start
+    // basename_end - basename_start == 6
+    // strlen("example") == 7
+    size_t const basename_length = (basename_end - basename_start) + 1;
+    if (basename_length >= 1)
+    {
+        char * buff =
+            (char *)_xo_args_tracked_alloc(context, basename_length + 1);
+        memcpy(buff, basename_start, basename_length);
+        buff[basename_length] = '\0';
+        return buff;
+    }
+    // There is no string to copy.
+    return NULL;
+}
 
-            context->print("Error: Invalid value provided for %s\n"
-                           "expected true or false.\n",
-                           context->argv[*argv_index]);
-            return false;
-        }
+////////////////////////////////////////////////////////////////////////////////
+bool _xo_isalnum(char const c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')
+           || (c >= '0' && c <= '9') || (c == '-');
+}
 
-        size_t const next_index = (*argv_index) + 1;
-        if (next_index >= (size_t)context->argc)
+////////////////////////////////////////////////////////////////////////////////
+bool _xo_isalnum_str(char const * const start, char const * const end)
+{
+    char const * const last = (NULL != end ? end : (start + strlen(start))) - 1;
+    char const * curr = start;
+    while (curr != last)
+    {
+        if (false == _xo_isalnum(*curr))
         {
-            context->print("Error: No value provided for %s\n",
-                           context->argv[*argv_index]);
             return false;
         }
-        char const * const next_value = context->argv[next_index];
+        ++curr;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void _xo_print_try_help(xo_args_ctx const * const context)
+{
+    context->print("Try: %s --help\n", context->app_name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Appends text to a writer. Bytes past the end of the buffer are dropped but
+// still counted so the caller can learn how large the buffer needs to be.
+typedef struct _xo_args_writer
+{
+    char * buffer;
+    size_t buffer_size;
+    size_t length;
+} _xo_args_writer;
+
+////////////////////////////////////////////////////////////////////////////////
+void _xo_args_write(_xo_args_writer * const writer,
+                    char const * const str,
+                    size_t const length)
+{
+    if (writer->length < writer->buffer_size)
+    {
+        size_t const space = writer->buffer_size - writer->length;
+        memcpy(&writer->buffer[writer->length],
+               str,
+               length < space ? length : space);
+    }
+    writer->length += length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void _xo_args_write_str(_xo_args_writer * const writer, char const * const str)
+{
+    _xo_args_write(writer, str, strlen(str));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void _xo_args_write_spaces(_xo_args_writer * const writer, size_t count)
+{
+    static char const spaces[] = "                ";
+    while (count > 0)
+    {
+        size_t const chunk =
+            count < sizeof(spaces) - 1 ? count : sizeof(spaces) - 1;
+        _xo_args_write(writer, spaces, chunk);
+        count -= chunk;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool _xo_args_shows_only_short_name(xo_args_arg const * const arg)
+{
+    return (NULL != arg->short_name)
+           && (arg->name_length == arg->short_name_length)
+           && (0 == strcmp(arg->name, arg->short_name));
+}
 
-        if (_xo_args_try_parse_bool(next_value,
-                                    &((_xo_args_arg_single *)arg)->value._bool))
+////////////////////////////////////////////////////////////////////////////////
+void _xo_args_render_arg_help(_xo_args_writer * const writer,
+                              xo_args_arg const * const arg,
+                              size_t const left_column_width)
+{
+    size_t const start = writer->length;
+    if (_xo_args_shows_only_short_name(arg))
+    {
+        _xo_args_write(writer, "  -", 3);
+        _xo_args_write(writer, arg->short_name, arg->short_name_length);
+    }
+    else
+    {
+        _xo_args_write(writer, "  --", 4);
+        _xo_args_write(writer, arg->name, arg->name_length);
+        if (NULL != arg->short_name)
         {
-            arg->has_value = true;
-            *argv_index = next_index;
-            return true;
+            _xo_args_write(writer, ", -", 3);
+            _xo_args_write(writer, arg->short_name, arg->short_name_length);
         }
+    }
+    if (arg->value_tip_length != 0)
+    {
+        _xo_args_write(writer, " ", 1);
+        _xo_args_write(writer, arg->value_tip, arg->value_tip_length);
+    }
 
-        context->print("Error: Invalid value provided for %s\n"
-                       "expected true or false.\n",
-                       context->argv[*argv_index]);
-        return false;
+    size_t const left_length = writer->length - start;
+    if (left_length < left_column_width)
+    {
+        _xo_args_write_spaces(writer, left_column_width - left_length);
     }
-    else if (arg->flags & XO_ARGS_TYPE_INT)
+
+    if (NULL != arg->description)
     {
-        if (_XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME == match->match_type
-            || _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_SHORT_NAME == match->match_type)
-        {
-            // This is an offset from the start of the user-input argument until
-            // the value begins (after the assignment operator). The value 3
-            // accounts for "--" and "=" in a name based assignment.. The value
-            // 2 accounts for a single "-" and "=" in a short name assignment.
-            size_t const offset =
-                ((_XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME == match->match_type) ? 3
-                                                                            : 2)
-                + match->matched_name_length;
+        // todo: wrap after some width
+        _xo_args_write(writer, arg->description, arg->description_length);
+    }
+    _xo_args_write(writer, "\n", 1);
+}
 
-            char const * const argv_value = context->argv[*argv_index];
+////////////////////////////////////////////////////////////////////////////////
+size_t _xo_args_help_left_column_width(xo_args_ctx const * const context)
+{
+    size_t left_column_width = 0;
+    for (size_t i = 0; i < context->args_size; ++i)
+    {
+        xo_args_arg const * const arg = context->args[i];
+        // 8 for an indent of 2 spaces, "--" before the name and a buffer of 4
+        // after everything
+        size_t arg_column_space_needed = 8;
+        arg_column_space_needed += arg->name_length;
+        arg_column_space_needed +=
+            (arg->value_tip_length != 0) ? arg->value_tip_length + 1 : 0;
 
-            int64_t parsed_value;
-            if (true
-                == _xo_args_try_parse_int(&argv_value[offset], &parsed_value))
+        if (NULL != arg->short_name)
+        {
+            // As a special case if the name and short name are the same:
+            // we just print the short name.
+            if (_xo_args_shows_only_short_name(arg))
+            {
+                arg_column_space_needed = 7;
+                arg_column_space_needed += arg->short_name_length;
+                arg_column_space_needed += (arg->value_tip_length != 0)
+                                               ? arg->value_tip_length + 1
+                                               : 0;
+            }
+            else
             {
-                ((_xo_args_arg_single *)arg)->value._int = parsed_value;
-                arg->has_value = true;
-                return true;
+                // 2 for ", " between the name and short name
+                arg_column_space_needed += 2 + arg->short_name_length;
             }
+        }
+        left_column_width = (left_column_width < arg_column_space_needed)
+                                ? arg_column_space_needed
+                                : left_column_width;
+    }
+    return left_column_width;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void _xo_args_render_help(xo_args_ctx const * const context,
+                          _xo_args_writer * const writer,
+                          size_t const left_column_width)
+{
+    _xo_args_write(writer, context->app_name, context->app_name_length);
+    if (NULL != context->app_version)
+    {
+        _xo_args_write(writer, " version ", 9);
+        _xo_args_write(
+            writer, context->app_version, context->app_version_length);
+    }
+    _xo_args_write(writer, "\n", 1);
 
-            context->print("Error: Value for %.*s is not a valid integer or is "
-                           "out of range\n",
-                           offset - 1u,
-                           context->argv[*argv_index]);
+    _xo_args_write(writer, "Usage: ", 7);
+    _xo_args_write(writer, context->app_name, context->app_name_length);
 
-            return false;
-        }
-        char const * argv_name = context->argv[*argv_index];
-        size_t const next_index = (*argv_index) + 1;
-        if (next_index >= (size_t)context->argc)
+    bool any_required = false;
+    for (size_t i = 0; i < context->args_size; ++i)
+    {
+        xo_args_arg const * const arg = context->args[i];
+        if (arg->flags & XO_ARGS_ARG_REQUIRED)
         {
-            context->print("Error: No value provided for %s\n",
-                           context->argv[*argv_index]);
-            return false;
+            _xo_args_write(writer, " --", 3);
+            _xo_args_write(writer, arg->name, arg->name_length);
+            any_required = true;
         }
+    }
 
-        int64_t parsed_value;
-        if (true
-            == _xo_args_try_parse_int(context->argv[next_index], &parsed_value))
+    bool any_optional = false;
+    for (size_t i = 0; i < context->args_size; ++i)
+    {
+        xo_args_arg const * const arg = context->args[i];
+        if (false == !!(arg->flags & XO_ARGS_ARG_REQUIRED))
         {
-            ((_xo_args_arg_single *)arg)->value._int = parsed_value;
-            arg->has_value = true;
-            *argv_index = next_index;
-            return true;
+            any_optional = true;
         }
+    }
 
-        context->print("Error: Value for %s is not a valid integer or is "
-                       "out of range\n",
-                       argv_name);
+    if (any_optional)
+    {
+        _xo_args_write_str(writer, " [OPTIONS]...\n");
+    }
 
-        return false;
+    if (NULL != context->app_documentation)
+    {
+        _xo_args_write(writer,
+                       context->app_documentation,
+                       context->app_documentation_length);
+        _xo_args_write(writer, "\n", 1);
     }
-    else if (arg->flags & XO_ARGS_TYPE_DOUBLE)
+
+    if (any_required)
     {
-        if (_XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME == match->match_type
-            || _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_SHORT_NAME == match->match_type)
+        if (any_optional)
         {
-            // This is an offset from the start of the user-input argument until
-            // the value begins (after the assignment operator). The value 3
-            // accounts for "--" and "=" in a name based assignment.. The value
-            // 2 accounts for a single "-" and "=" in a short name assignment.
-            size_t const offset =
-                ((_XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME == match->match_type) ? 3
-                                                                            : 2)
-                + match->matched_name_length;
-
-            char const * const argv_value = context->argv[*argv_index];
-
-            double parsed_value;
-            if (true
-                == _xo_args_try_parse_double(&argv_value[offset],
-                                             &parsed_value))
+            _xo_args_write_str(writer, "REQUIRED ARGUMENTS:\n");
+        }
+        for (size_t i = 0; i < context->args_size; ++i)
+        {
+            xo_args_arg const * const arg = context->args[i];
+            if (arg->flags & XO_ARGS_ARG_REQUIRED)
             {
-                ((_xo_args_arg_single *)arg)->value._double = parsed_value;
-                arg->has_value = true;
-                return true;
+                _xo_args_render_arg_help(writer, arg, left_column_width);
             }
-
-            context->print("Error: Value for %.*s is not a valid number or is "
-                           "out of range\n",
-                           offset - 1u,
-                           context->argv[*argv_index]);
-
-            return false;
         }
+    }
 
-        char const * argv_name = context->argv[*argv_index];
-        size_t const next_index = (*argv_index) + 1;
-        if (next_index >= (size_t)context->argc)
+    if (any_optional)
+    {
+        if (any_required)
         {
-            context->print("Error: No value provided for %s\n",
-                           context->argv[*argv_index]);
-            return false;
+            _xo_args_write_str(writer, "OPTIONAL ARGUMENTS:\n");
         }
-
-        double parsed_value;
-        if (true
-            == _xo_args_try_parse_double(context->argv[next_index],
-                                         &parsed_value))
+        for (size_t i = 0; i < context->args_size; ++i)
         {
-            ((_xo_args_arg_single *)arg)->value._double = parsed_value;
-            arg->has_value = true;
-            *argv_index = next_index;
-            return true;
+            xo_args_arg const * const arg = context->args[i];
+            if (XO_ARGS_ARG_REQUIRED != (arg->flags & XO_ARGS_ARG_REQUIRED))
+            {
+                _xo_args_render_arg_help(writer, arg, left_column_width);
+            }
         }
+    }
+}
 
-        context->print("Error: Value for %s is not a valid number or is "
-                       "out of range\n",
-                       argv_name);
-
-        return false;
+////////////////////////////////////////////////////////////////////////////////
+size_t xo_args_render_help(xo_args_ctx const * const context,
+                           char * const buffer,
+                           size_t const buffer_size)
+{
+    _XO_ARGS_STATS_START();
+    _xo_args_writer writer;
+    writer.buffer = buffer;
+    writer.buffer_size = NULL == buffer ? 0 : buffer_size;
+    writer.length = 0;
+    if (NULL != context->help_text)
+    {
+        _xo_args_write(&writer, context->help_text, context->help_text_length);
     }
-    // For string arrays we expect and consume the next argument no matter what
-    // then we continue to take the following strings until a valid argument is
-    // encountered or we are out of arguments.
-    // For an obtuse example if we want to have the string array foo with the
-    // values in order: ['a', '-b', '--foo', 'bar'] then the user could execute
-    // the program like so:
-    //      program --foo a -b --foo --foo bar
-    //
-    //      argv[0] "program"   - The program we're running.
-    //      argv[1] "--foo"     - This is a named argument so we start parsing
-    //                            the following values as an array.
-    //      argv[2] "a"         - This is the first value in the foo array.
-    //      argv[3] "-b"        - This is the second value in the foo array
-    //                            **assuming** there is no variable with the
-    //                            short name 'b'.
-    //      argv[4] "--foo"     - This is a named argument so we start parsing
-    //                            the following values as an array.
-    //      argv[5] "--foo"     - This is the third element of the foo array.
-    //                            It is not treated as a named argument because
-    //                            it is the first value following a named
-    //                            argument.
-    //      argv[6] "bar"        - This is the fourth element of the foo array.
-    else if (arg->flags & XO_ARGS_TYPE_STRING_ARRAY)
+    else
     {
-        _xo_args_arg_array * const array = (_xo_args_arg_array *)arg;
-        size_t next_index = (*argv_index) + 1;
-        if (next_index >= (size_t)context->argc)
-        {
-            context->print("Error: No value provided for %s\n",
-                           context->argv[*argv_index]);
-            return false;
-        }
+        _xo_args_render_help(
+            context, &writer, _xo_args_help_left_column_width(context));
+    }
+    if (writer.buffer_size > 0)
+    {
+        size_t const end = writer.length < writer.buffer_size
+                               ? writer.length
+                               : writer.buffer_size - 1;
+        writer.buffer[end] = '\0';
+    }
+    // A frozen schema may be rendered on several threads at once and is never
+    // modified, so its statistics are left alone.
+    if (false == context->frozen)
+    {
+        _XO_ARGS_STATS_STOP(context, help_ns);
+    }
+    return writer.length;
+}
 
-        char const * next_value = context->argv[next_index];
-        size_t next_value_len = strlen(next_value);
-        char * buff =
-            (char *)_xo_args_tracked_alloc(context, next_value_len + 1);
-        memcpy(buff, next_value, next_value_len + 1);
-        _xo_args_arg_array_push(context, array, (void *)&buff, sizeof(char *));
-        arg->has_value = true;
-        *argv_index = next_index;
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_print_help(xo_args_ctx const * const context)
+{
+    if (NULL != context->help_text)
+    {
+        context->print("%s", context->help_text);
+        return;
+    }
 
-        // Consume every following value until we see a valid argument
-        for (++next_index; next_index < (size_t)context->argc; ++next_index)
-        {
-            next_value = context->argv[next_index];
-            next_value_len = strlen(next_value);
+    // Measure first so the whole page is rendered into one exact-size buffer
+    // and handed to print in a single call.
+    size_t const length = xo_args_render_help(context, NULL, 0);
+    char * const text = (char *)context->alloc(length + 1);
+    if (NULL == text)
+    {
+        XO_ARGS_ASSERT(NULL != text, "Failed to allocate the help text.");
+        return;
+    }
+    xo_args_render_help(context, text, length + 1);
+    context->print("%s", text);
+    context->free(text);
+}
 
-            for (size_t j = 0; j < context->args_size; ++j)
-            {
-                xo_args_arg const * const other_arg = context->args[j];
-                if (_xo_args_arg_matches_input(other_arg, next_value, NULL))
-                {
-                    // The next argument is a valid arg so don't parse
-                    // that as a value of this string array
-                    return true;
-                }
+////////////////////////////////////////////////////////////////////////////////
+char const * xo_args_get_help(xo_args_ctx const * const context,
+                              size_t * const out_length)
+{
+    if (NULL != out_length)
+    {
+        *out_length = context->help_text_length;
+    }
+    return context->help_text;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void _xo_args_clear_help_cache(xo_args_ctx * const context)
+{
+    if (NULL != context->help_text)
+    {
+        _xo_args_tracked_free(context, context->help_text);
+        context->help_text = NULL;
+        context->help_text_length = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Renders the help text into a tracked allocation owned by the context. The
+// left column width is computed once and shared by the measuring and the
+// rendering pass.
+void _xo_args_cache_help(xo_args_ctx * const context)
+{
+    _XO_ARGS_STATS_START();
+    _xo_args_clear_help_cache(context);
+
+    size_t const left_column_width = _xo_args_help_left_column_width(context);
+    _xo_args_writer writer;
+    writer.buffer = NULL;
+    writer.buffer_size = 0;
+    writer.length = 0;
+    _xo_args_render_help(context, &writer, left_column_width);
+
+    size_t const length = writer.length;
+    writer.buffer = (char *)_xo_args_tracked_alloc(context, length + 1);
+    writer.buffer_size = length + 1;
+    writer.length = 0;
+    _xo_args_render_help(context, &writer, left_column_width);
+    writer.buffer[length] = '\0';
+
+    context->help_text = writer.buffer;
+    context->help_text_length = length;
+    _XO_ARGS_STATS_STOP(context, help_ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_print_version(xo_args_ctx const * const context)
+{
+    if (NULL != context->app_version)
+    {
+        context->print(
+            "%s version %s\n", context->app_name, context->app_version);
+    }
+    else
+    {
+        XO_ARGS_ASSERT(NULL != context->app_version,
+                       "No version string was "
+                       "provided but xo_args_print_version was called.");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+xo_args_ctx * xo_args_create_ctx_with_options(
+    xo_argc_t const argc,
+    xo_argv_t const argv,
+    xo_args_ctx_options const * const options)
+{
+    xo_args_ctx_options default_options;
+    if (NULL == options)
+    {
+        memset(&default_options, 0, sizeof(default_options));
+    }
+    xo_args_ctx_options const * const opts =
+        NULL != options ? options : &default_options;
+
+    char const * const app_name = opts->app_name;
+    char const * const app_version = opts->app_version;
+    char const * const app_documentation = opts->app_documentation;
+    xo_args_alloc_fn const alloc_fn = opts->alloc_fn;
+    xo_args_realloc_fn const realloc_fn = opts->realloc_fn;
+    xo_args_free_fn const free_fn = opts->free_fn;
+    xo_args_print_fn const print_fn = opts->print_fn;
+
+    if (argc < 1)
+    {
+        XO_ARGS_ASSERT(argc >= 1, "argc is expected to be >= 1");
+        (print_fn != NULL ? print_fn : printf)("xo-args error: %s argc is"
+                                               " expected to be >= 1 but was"
+                                               "%i\n",
+                                               __func__,
+                                               argc);
+        return NULL;
+    }
+
+    if (NULL == argv)
+    {
+        XO_ARGS_ASSERT(NULL != argv, "argv is required");
+        (print_fn != NULL ? print_fn : printf)("xo-args error: %s argv is"
+                                               " required\n",
+                                               __func__);
+        return NULL;
+    }
+
+    {
+        bool any_arg_is_null = false;
+        for (int i = 0; i < argc; ++i)
+        {
+            if (NULL == argv[i])
+            {
+                (print_fn != NULL ? print_fn : printf)("xo-args error: %s"
+                                                       " argv[%i] was NULL\n",
+                                                       __func__,
+                                                       i);
+                any_arg_is_null = true;
             }
+        }
+
+        if (any_arg_is_null)
+        {
+            XO_ARGS_ASSERT(false == any_arg_is_null,
+                           "one or more arguments in argv was null");
+            return NULL;
+        }
+    }
+
+    xo_args_ctx * const context =
+        (xo_args_ctx *)(NULL != alloc_fn ? alloc_fn(sizeof(xo_args_ctx))
+                                         : malloc(sizeof(xo_args_ctx)));
+
+    context->argc = argc;
+    context->argv = argv;
+    context->flags = opts->flags;
+    context->print = NULL == print_fn ? printf : print_fn;
+    context->alloc = NULL == alloc_fn ? malloc : alloc_fn;
+    context->realloc = NULL == realloc_fn ? realloc : realloc_fn;
+    context->free = NULL == free_fn ? free : free_fn;
+    context->arena = NULL;
+    context->arena_chunk_size =
+        0 != opts->arena_chunk_size ? opts->arena_chunk_size : 4096;
+    context->value_threads = opts->value_threads;
+    context->allocations_size = 0;
+    if (context->flags & XO_ARGS_CTX_ARENA)
+    {
+        context->allocations_reserved = 0;
+        context->allocations = NULL;
+    }
+    else
+    {
+        context->allocations_reserved = 8;
+        context->allocations = (void **)context->alloc(
+            context->allocations_reserved * sizeof(void *));
+    }
+    context->tokens = NULL;
+    context->tokens_reserved = 0;
+    context->tokens_size = 0;
+    context->response_files = NULL;
+    context->index = NULL;
+    context->index_reserved = 0;
+    context->indexed_args = 0;
+    context->help_text = NULL;
+    context->help_text_length = 0;
+    context->help_arg = NULL;
+    context->version_arg = NULL;
+    context->stream_arg = NULL;
+    context->stream_values = 0;
+    context->stream_short = false;
+    context->parse_started = false;
+    context->parse_failed = false;
+    context->parse_finished = false;
+    context->schema = NULL;
+    context->frozen = false;
+#if defined(XO_ARGS_STATS)
+    memset(&context->stats, 0, sizeof(context->stats));
+    context->tracked_bytes = 0;
+#endif
+
+    // Default app_name is the filename parsed from argv[0]
+    if (NULL == app_name)
+    {
+        context->app_name = _xo_args_basename(context, argv[0]);
+        if (NULL == context->app_name)
+        {
+            // We never free app_name directly so this assignment is safe
+            context->app_name = "app";
+        }
+
+        context->app_name_length = strlen(context->app_name);
+    }
+    else
+    {
+        size_t const len = strlen(app_name);
+        char * buff = (char *)_xo_args_tracked_alloc(context, len + 1);
+        memcpy(buff, app_name, len + 1);
+        context->app_name = buff;
+        context->app_name_length = len;
+    }
+
+    if (NULL == app_version)
+    {
+        // A NULL app_version is supported. We just won't print the version in
+        // the help text.
+        context->app_version = NULL;
+        context->app_version_length = 0;
+    }
+    else
+    {
+        size_t const len = strlen(app_version);
+        char * buff = (char *)_xo_args_tracked_alloc(context, len + 1);
+        memcpy(buff, app_version, len + 1);
+        context->app_version = buff;
+        context->app_version_length = len;
+    }
+
+    if (NULL == app_documentation)
+    {
+        // NULL app_documentation is supported. We just won't print the
+        // documentation in the help text.
+        context->app_documentation = NULL;
+        context->app_documentation_length = 0;
+    }
+    else
+    {
+        size_t const len = strlen(app_documentation);
+        char * buff = (char *)_xo_args_tracked_alloc(context, len + 1);
+        memcpy(buff, app_documentation, len + 1);
+        context->app_documentation = buff;
+        context->app_documentation_length = len;
+    }
+
+    context->args_size = 0;
+    context->args_reserved = 4;
+    context->args = (xo_args_arg **)_xo_args_tracked_alloc(
+        context, context->args_reserved * sizeof(xo_args_arg *));
+
+    return context;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+xo_args_ctx * xo_args_create_ctx_advanced(xo_argc_t const argc,
+                                          xo_argv_t const argv,
+                                          char const * const app_name,
+                                          char const * const app_version,
+                                          char const * const app_documentation,
+                                          xo_args_alloc_fn const alloc_fn,
+                                          xo_args_realloc_fn const realloc_fn,
+                                          xo_args_free_fn const free_fn,
+                                          xo_args_print_fn const print_fn)
+{
+    xo_args_ctx_options options;
+    memset(&options, 0, sizeof(options));
+    options.app_name = app_name;
+    options.app_version = app_version;
+    options.app_documentation = app_documentation;
+    options.alloc_fn = alloc_fn;
+    options.realloc_fn = realloc_fn;
+    options.free_fn = free_fn;
+    options.print_fn = print_fn;
+    return xo_args_create_ctx_with_options(argc, argv, &options);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+xo_args_ctx * xo_args_create_ctx(xo_argc_t const argc, xo_argv_t const argv)
+{
+    return xo_args_create_ctx_advanced(argc,
+                                       argv,
+                                       /*app_name*/ NULL,
+                                       /*app_version*/ NULL,
+                                       /*app_documentation*/ NULL,
+                                       /*alloc_fn*/ NULL,
+                                       /*realloc_fn*/ NULL,
+                                       /*free_fn*/ NULL,
+                                       /*print_fn*/ NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the value of c as a hexadecimal digit or 16 if it isn't one.
+unsigned _xo_args_digit_value(char const c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return (unsigned)(c - '0');
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return (unsigned)(c - 'a') + 10u;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return (unsigned)(c - 'A') + 10u;
+    }
+    return 16u;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Parses the length characters at input as an integer. This accepts exactly
+// what strtoll(input, &end, 0) accepts when it consumes the whole input
+// without overflowing: an optional sign followed by a "0x" or "0X" prefixed
+// hexadecimal, a "0" prefixed octal or a decimal number. Unlike strtoll,
+// leading whitespace is rejected rather than skipped.
+bool _xo_args_try_parse_int(char const * const input,
+                            size_t const length,
+                            int64_t * out_int)
+{
+    char const * curr = input;
+    char const * const end = input + length;
+    if (curr == end)
+    {
+        return false;
+    }
+
+    bool const negative = '-' == *curr;
+    if (negative || '+' == *curr)
+    {
+        ++curr;
+        if (curr == end)
+        {
+            return false;
+        }
+    }
+
+    unsigned base = 10u;
+    if ('0' == *curr)
+    {
+        // strtoll only takes "0x" as a prefix when a hex digit follows it.
+        // Otherwise it parses the "0" and stops at the 'x', which we reject
+        // below as an invalid octal digit.
+        if (end - curr > 2 && ('x' == curr[1] || 'X' == curr[1])
+            && _xo_args_digit_value(curr[2]) < 16u)
+        {
+            base = 16u;
+            curr += 2;
+        }
+        else
+        {
+            base = 8u;
+        }
+    }
+
+    // The largest magnitude we can hold: INT64_MAX or -INT64_MIN.
+    uint64_t const limit =
+        negative ? (uint64_t)INT64_MAX + 1u : (uint64_t)INT64_MAX;
+    uint64_t const cutoff = limit / base;
+    unsigned const cutlim = (unsigned)(limit % base);
+
+    uint64_t value = 0;
+    for (; curr != end; ++curr)
+    {
+        unsigned const digit = _xo_args_digit_value(*curr);
+        if (digit >= base)
+        {
+            return false;
+        }
+        if (value > cutoff || (value == cutoff && digit > cutlim))
+        {
+            return false;
+        }
+        value = value * base + digit;
+    }
+
+    // Written this way to avoid converting 2^63 to int64_t for INT64_MIN.
+    *out_int = (negative && value != 0) ? -(int64_t)(value - 1u) - 1
+                                        : (int64_t)value;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool _xo_args_try_parse_bool(char const * const input, bool * out_bool)
+{
+    if ((0 == strcmp(input, "0")) || (0 == strcmp(input, "false"))
+        || (0 == strcmp(input, "False")) || (0 == strcmp(input, "FALSE")))
+    {
+        *out_bool = false;
+        return true;
+    }
+    else if ((0 == strcmp(input, "1")) || (0 == strcmp(input, "true"))
+             || (0 == strcmp(input, "True")) || (0 == strcmp(input, "TRUE")))
+    {
+        *out_bool = true;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+#if !defined(XO_ARGS_USE_STRTOD)
+////////////////////////////////////////////////////////////////////////////////
+// 5^q for q in [-64, 64], normalized so the most significant of the 128 bits
+// is set. Positive powers are truncated and negative powers are rounded up.
+// This is the table used by the Eisel-Lemire algorithm, limited to the
+// exponents command line values realistically use; everything else is handled
+// by _xo_args_decimal_to_double.
+#define _XO_ARGS_POW5_MIN (-64)
+#define _XO_ARGS_POW5_MAX 64
+uint64_t const g_xo_args_powers_of_five[129][2] = {
+    {0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull}, // 5^-64
+    {0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull}, // 5^-63
+    {0x83a3eeeef9153e89ull, 0x1953cf68300424acull}, // 5^-62
+    {0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull}, // 5^-61
+    {0xcdb02555653131b6ull, 0x3792f412cb06794dull}, // 5^-60
+    {0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull}, // 5^-59
+    {0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull}, // 5^-58
+    {0xc8de047564d20a8bull, 0xf245825a5a445275ull}, // 5^-57
+    {0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull}, // 5^-56
+    {0x9ced737bb6c4183dull, 0x55464dd69685606bull}, // 5^-55
+    {0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull}, // 5^-54
+    {0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull}, // 5^-53
+    {0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull}, // 5^-52
+    {0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull}, // 5^-51
+    {0xef73d256a5c0f77cull, 0x963e66858f6d4440ull}, // 5^-50
+    {0x95a8637627989aadull, 0xdde7001379a44aa8ull}, // 5^-49
+    {0xbb127c53b17ec159ull, 0x5560c018580d5d52ull}, // 5^-48
+    {0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull}, // 5^-47
+    {0x9226712162ab070dull, 0xcab3961304ca70e8ull}, // 5^-46
+    {0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull}, // 5^-45
+    {0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull}, // 5^-44
+    {0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull}, // 5^-43
+    {0xb267ed1940f1c61cull, 0x55f038b237591ed3ull}, // 5^-42
+    {0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull}, // 5^-41
+    {0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull}, // 5^-40
+    {0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull}, // 5^-39
+    {0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull}, // 5^-38
+    {0x881cea14545c7575ull, 0x7e50d64177da2e54ull}, // 5^-37
+    {0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull}, // 5^-36
+    {0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull}, // 5^-35
+    {0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull}, // 5^-34
+    {0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull}, // 5^-33
+    {0xcfb11ead453994baull, 0x67de18eda5814af2ull}, // 5^-32
+    {0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull}, // 5^-31
+    {0xa2425ff75e14fc31ull, 0xa1258379a94d028dull}, // 5^-30
+    {0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull}, // 5^-29
+    {0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull}, // 5^-28
+    {0x9e74d1b791e07e48ull, 0x775ea264cf55347eull}, // 5^-27
+    {0xc612062576589ddaull, 0x95364afe032a819eull}, // 5^-26
+    {0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull}, // 5^-25
+    {0x9abe14cd44753b52ull, 0xc4926a9672793543ull}, // 5^-24
+    {0xc16d9a0095928a27ull, 0x75b7053c0f178294ull}, // 5^-23
+    {0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull}, // 5^-22
+    {0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull}, // 5^-21
+    {0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull}, // 5^-20
+    {0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull}, // 5^-19
+    {0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull}, // 5^-18
+    {0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull}, // 5^-17
+    {0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull}, // 5^-16
+    {0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull}, // 5^-15
+    {0xb424dc35095cd80full, 0x538484c19ef38c95ull}, // 5^-14
+    {0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull}, // 5^-13
+    {0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull}, // 5^-12
+    {0xafebff0bcb24aafeull, 0xf78f69a51539d749ull}, // 5^-11
+    {0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull}, // 5^-10
+    {0x89705f4136b4a597ull, 0x31680a88f8953031ull}, // 5^-9
+    {0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull}, // 5^-8
+    {0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull}, // 5^-7
+    {0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull}, // 5^-6
+    {0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull}, // 5^-5
+    {0xd1b71758e219652bull, 0xd3c36113404ea4a9ull}, // 5^-4
+    {0x83126e978d4fdf3bull, 0x645a1cac083126eaull}, // 5^-3
+    {0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull}, // 5^-2
+    {0xccccccccccccccccull, 0xcccccccccccccccdull}, // 5^-1
+    {0x8000000000000000ull, 0x0000000000000000ull}, // 5^0
+    {0xa000000000000000ull, 0x0000000000000000ull}, // 5^1
+    {0xc800000000000000ull, 0x0000000000000000ull}, // 5^2
+    {0xfa00000000000000ull, 0x0000000000000000ull}, // 5^3
+    {0x9c40000000000000ull, 0x0000000000000000ull}, // 5^4
+    {0xc350000000000000ull, 0x0000000000000000ull}, // 5^5
+    {0xf424000000000000ull, 0x0000000000000000ull}, // 5^6
+    {0x9896800000000000ull, 0x0000000000000000ull}, // 5^7
+    {0xbebc200000000000ull, 0x0000000000000000ull}, // 5^8
+    {0xee6b280000000000ull, 0x0000000000000000ull}, // 5^9
+    {0x9502f90000000000ull, 0x0000000000000000ull}, // 5^10
+    {0xba43b74000000000ull, 0x0000000000000000ull}, // 5^11
+    {0xe8d4a51000000000ull, 0x0000000000000000ull}, // 5^12
+    {0x9184e72a00000000ull, 0x0000000000000000ull}, // 5^13
+    {0xb5e620f480000000ull, 0x0000000000000000ull}, // 5^14
+    {0xe35fa931a0000000ull, 0x0000000000000000ull}, // 5^15
+    {0x8e1bc9bf04000000ull, 0x0000000000000000ull}, // 5^16
+    {0xb1a2bc2ec5000000ull, 0x0000000000000000ull}, // 5^17
+    {0xde0b6b3a76400000ull, 0x0000000000000000ull}, // 5^18
+    {0x8ac7230489e80000ull, 0x0000000000000000ull}, // 5^19
+    {0xad78ebc5ac620000ull, 0x0000000000000000ull}, // 5^20
+    {0xd8d726b7177a8000ull, 0x0000000000000000ull}, // 5^21
+    {0x878678326eac9000ull, 0x0000000000000000ull}, // 5^22
+    {0xa968163f0a57b400ull, 0x0000000000000000ull}, // 5^23
+    {0xd3c21bcecceda100ull, 0x0000000000000000ull}, // 5^24
+    {0x84595161401484a0ull, 0x0000000000000000ull}, // 5^25
+    {0xa56fa5b99019a5c8ull, 0x0000000000000000ull}, // 5^26
+    {0xcecb8f27f4200f3aull, 0x0000000000000000ull}, // 5^27
+    {0x813f3978f8940984ull, 0x4000000000000000ull}, // 5^28
+    {0xa18f07d736b90be5ull, 0x5000000000000000ull}, // 5^29
+    {0xc9f2c9cd04674edeull, 0xa400000000000000ull}, // 5^30
+    {0xfc6f7c4045812296ull, 0x4d00000000000000ull}, // 5^31
+    {0x9dc5ada82b70b59dull, 0xf020000000000000ull}, // 5^32
+    {0xc5371912364ce305ull, 0x6c28000000000000ull}, // 5^33
+    {0xf684df56c3e01bc6ull, 0xc732000000000000ull}, // 5^34
+    {0x9a130b963a6c115cull, 0x3c7f400000000000ull}, // 5^35
+    {0xc097ce7bc90715b3ull, 0x4b9f100000000000ull}, // 5^36
+    {0xf0bdc21abb48db20ull, 0x1e86d40000000000ull}, // 5^37
+    {0x96769950b50d88f4ull, 0x1314448000000000ull}, // 5^38
+    {0xbc143fa4e250eb31ull, 0x17d955a000000000ull}, // 5^39
+    {0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull}, // 5^40
+    {0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull}, // 5^41
+    {0xb7abc627050305adull, 0xf14a3d9e40000000ull}, // 5^42
+    {0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull}, // 5^43
+    {0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull}, // 5^44
+    {0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull}, // 5^45
+    {0xe0352f62a19e306eull, 0xd50b2037ad200000ull}, // 5^46
+    {0x8c213d9da502de45ull, 0x4526f422cc340000ull}, // 5^47
+    {0xaf298d050e4395d6ull, 0x9670b12b7f410000ull}, // 5^48
+    {0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull}, // 5^49
+    {0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull}, // 5^50
+    {0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull}, // 5^51
+    {0xd5d238a4abe98068ull, 0x72a4904598d6d880ull}, // 5^52
+    {0x85a36366eb71f041ull, 0x47a6da2b7f864750ull}, // 5^53
+    {0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull}, // 5^54
+    {0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull}, // 5^55
+    {0x82818f1281ed449full, 0xbff8f10e7a8921a4ull}, // 5^56
+    {0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull}, // 5^57
+    {0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull}, // 5^58
+    {0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull}, // 5^59
+    {0x9f4f2726179a2245ull, 0x01d762422c946590ull}, // 5^60
+    {0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull}, // 5^61
+    {0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull}, // 5^62
+    {0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full}, // 5^63
+    {0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull}, // 5^64
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the high 64 bits of a * b and stores the low 64 bits in out_low.
+uint64_t _xo_args_mul_128(uint64_t const a,
+                          uint64_t const b,
+                          uint64_t * const out_low)
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 const product =
+        (unsigned __int128)a * (unsigned __int128)b;
+    *out_low = (uint64_t)product;
+    return (uint64_t)(product >> 64);
+#else
+    uint64_t const a_lo = a & 0xffffffffu;
+    uint64_t const a_hi = a >> 32;
+    uint64_t const b_lo = b & 0xffffffffu;
+    uint64_t const b_hi = b >> 32;
+
+    uint64_t const lo_lo = a_lo * b_lo;
+    uint64_t const hi_lo = a_hi * b_lo;
+    uint64_t const lo_hi = a_lo * b_hi;
+    uint64_t const hi_hi = a_hi * b_hi;
+
+    uint64_t const cross = (lo_lo >> 32) + (hi_lo & 0xffffffffu) + lo_hi;
+    *out_low = (cross << 32) | (lo_lo & 0xffffffffu);
+    return (hi_lo >> 32) + (cross >> 32) + hi_hi;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// value must not be 0.
+int _xo_args_leading_zeros_64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(value);
+#else
+    int count = 0;
+    while (0 == (value & 0x8000000000000000ull))
+    {
+        value <<= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The Eisel-Lemire algorithm: converts w * 10^q to the bits of the nearest
+// double. w must not be 0 and q must be within the powers of five table, which
+// also means the result is always a normal, finite double.
+uint64_t _xo_args_eisel_lemire(int const q, uint64_t w)
+{
+    int const lz = _xo_args_leading_zeros_64(w);
+    w <<= lz;
+
+    // We need 55 bits of precision: the 53 bits of the mantissa (including the
+    // implicit bit), a bit for rounding and a bit we may lose to upperbit
+    // below. The second half of the power only matters when the bits below
+    // those 55 are all set and the carry could reach them.
+    uint64_t const * const power =
+        g_xo_args_powers_of_five[q - _XO_ARGS_POW5_MIN];
+    uint64_t low;
+    uint64_t high = _xo_args_mul_128(w, power[0], &low);
+    if ((high & 0x1ffu) == 0x1ffu)
+    {
+        uint64_t second_low;
+        uint64_t const second_high = _xo_args_mul_128(w, power[1], &second_low);
+        low += second_high;
+        if (second_high > low)
+        {
+            ++high;
+        }
+    }
+
+    int const upperbit = (int)(high >> 63);
+    int const shift = upperbit + 9;
+    uint64_t mantissa = high >> shift;
+    // floor(q * log2(10)) + 63, then biased.
+    int power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz + 1023;
+
+    // Exactly halfway between two doubles: round to even rather than up. This
+    // can only happen when 5^q fits in 64 bits.
+    if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1
+        && (mantissa << shift) == high)
+    {
+        mantissa &= ~(uint64_t)1;
+    }
+
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    if (mantissa >= ((uint64_t)2 << 52))
+    {
+        mantissa = (uint64_t)1 << 52;
+        ++power2;
+    }
+    mantissa &= ~((uint64_t)1 << 52);
+    return ((uint64_t)power2 << 52) | mantissa;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// An arbitrary precision decimal used when the fast path can't be sure of the
+// correct rounding. This is the "simple decimal conversion" algorithm: the
+// number is shifted by powers of two until its binary exponent is known and
+// then the mantissa is read off the integer part. 800 digits is enough to
+// decide the rounding of any double.
+typedef struct _xo_args_decimal
+{
+    unsigned char digits[800]; // 0-9, not characters
+    int count;                 // number of digits used
+    int point;                 // position of the decimal point
+    bool truncated;            // discarded nonzero digits past digits[799]
+} _xo_args_decimal;
+
+#define _XO_ARGS_DECIMAL_CAPACITY 800
+#define _XO_ARGS_DECIMAL_MAX_SHIFT 60
+
+////////////////////////////////////////////////////////////////////////////////
+void _xo_args_decimal_trim(_xo_args_decimal * const d)
+{
+    while (d->count > 0 && 0 == d->digits[d->count - 1])
+    {
+        --d->count;
+    }
+    if (0 == d->count)
+    {
+        d->point = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Multiplies d by 2^k. k <= _XO_ARGS_DECIMAL_MAX_SHIFT.
+void _xo_args_decimal_shift_left(_xo_args_decimal * const d, unsigned const k)
+{
+    // Produce the digits least significant first, then copy them back.
+    unsigned char reversed[_XO_ARGS_DECIMAL_CAPACITY + 20];
+    int produced = 0;
+    uint64_t n = 0;
+    for (int r = d->count - 1; r >= 0; --r)
+    {
+        n += (uint64_t)d->digits[r] << k;
+        reversed[produced++] = (unsigned char)(n % 10);
+        n /= 10;
+    }
+    while (n > 0)
+    {
+        reversed[produced++] = (unsigned char)(n % 10);
+        n /= 10;
+    }
+
+    int const delta = produced - d->count;
+    int const kept = produced < _XO_ARGS_DECIMAL_CAPACITY
+                         ? produced
+                         : _XO_ARGS_DECIMAL_CAPACITY;
+    for (int i = 0; i < produced; ++i)
+    {
+        unsigned char const digit = reversed[produced - 1 - i];
+        if (i < kept)
+        {
+            d->digits[i] = digit;
+        }
+        else if (0 != digit)
+        {
+            d->truncated = true;
+        }
+    }
+    d->count = kept;
+    d->point += delta;
+    _xo_args_decimal_trim(d);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Divides d by 2^k. k <= _XO_ARGS_DECIMAL_MAX_SHIFT.
+void _xo_args_decimal_shift_right(_xo_args_decimal * const d, unsigned const k)
+{
+    int r = 0; // read index
+    int w = 0; // write index
+
+    // Pick up enough leading digits to cover the first shift.
+    uint64_t n = 0;
+    for (; 0 == (n >> k); ++r)
+    {
+        if (r >= d->count)
+        {
+            if (0 == n)
+            {
+                d->count = 0;
+                return;
+            }
+            while (0 == (n >> k))
+            {
+                n *= 10;
+                ++r;
+            }
+            break;
+        }
+        n = n * 10 + d->digits[r];
+    }
+    d->point -= r - 1;
+
+    uint64_t const mask = ((uint64_t)1 << k) - 1;
+
+    // Pick up a digit, put down a digit.
+    for (; r < d->count; ++r)
+    {
+        d->digits[w++] = (unsigned char)(n >> k);
+        n = (n & mask) * 10 + d->digits[r];
+    }
+
+    // Put down the remaining digits.
+    while (n > 0)
+    {
+        unsigned char const digit = (unsigned char)(n >> k);
+        n = (n & mask) * 10;
+        if (w < _XO_ARGS_DECIMAL_CAPACITY)
+        {
+            d->digits[w++] = digit;
+        }
+        else if (digit > 0)
+        {
+            d->truncated = true;
+        }
+    }
+
+    d->count = w;
+    _xo_args_decimal_trim(d);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void _xo_args_decimal_shift(_xo_args_decimal * const d, int k)
+{
+    if (0 == d->count)
+    {
+        return;
+    }
+    for (; k > _XO_ARGS_DECIMAL_MAX_SHIFT; k -= _XO_ARGS_DECIMAL_MAX_SHIFT)
+    {
+        _xo_args_decimal_shift_left(d, _XO_ARGS_DECIMAL_MAX_SHIFT);
+    }
+    for (; k < -_XO_ARGS_DECIMAL_MAX_SHIFT; k += _XO_ARGS_DECIMAL_MAX_SHIFT)
+    {
+        _xo_args_decimal_shift_right(d, _XO_ARGS_DECIMAL_MAX_SHIFT);
+    }
+    if (k > 0)
+    {
+        _xo_args_decimal_shift_left(d, (unsigned)k);
+    }
+    else if (k < 0)
+    {
+        _xo_args_decimal_shift_right(d, (unsigned)-k);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the integer part of d rounded to nearest, ties to even. d must be
+// less than 2^64.
+uint64_t _xo_args_decimal_rounded_integer(_xo_args_decimal const * const d)
+{
+    uint64_t n = 0;
+    int i = 0;
+    for (; i < d->point && i < d->count; ++i)
+    {
+        n = n * 10 + d->digits[i];
+    }
+    for (; i < d->point; ++i)
+    {
+        n *= 10;
+    }
+
+    int const at = d->point;
+    if (at >= 0 && at < d->count)
+    {
+        bool round_up = d->digits[at] >= 5;
+        if (5 == d->digits[at] && at + 1 == d->count && !d->truncated)
+        {
+            // Exactly halfway.
+            round_up = at > 0 && 1 == (d->digits[at - 1] & 1);
+        }
+        n += round_up ? 1u : 0u;
+    }
+    return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Converts d to the bits of the nearest double. Returns false on overflow or
+// when the result underflows: it is smaller than DBL_MIN after rounding to
+// 53 bits and it is inexact. These are the inputs strtod reports with ERANGE.
+bool _xo_args_decimal_to_double(_xo_args_decimal * const d,
+                                uint64_t * const out_bits)
+{
+    static int const powers[] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+    int const powers_count = (int)(sizeof(powers) / sizeof(powers[0]));
+
+    if (0 == d->count)
+    {
+        *out_bits = 0;
+        return true;
+    }
+    if (d->point > 310)
+    {
+        return false;
+    }
+    if (d->point < -330)
+    {
+        return false;
+    }
+
+    // Scale by powers of two until d is in [0.5, 1).
+    int exp = 0;
+    while (d->point > 0)
+    {
+        int const n = d->point >= powers_count ? 27 : powers[d->point];
+        _xo_args_decimal_shift(d, -n);
+        exp += n;
+    }
+    while (d->point < 0 || (0 == d->point && d->digits[0] < 5))
+    {
+        int const n = -d->point >= powers_count ? 27 : powers[-d->point];
+        _xo_args_decimal_shift(d, n);
+        exp -= n;
+    }
+    // d * 2^exp is now in [1, 2) * 2^exp.
+    --exp;
+
+    // Like glibc, tininess is decided after rounding to 53 bits with an
+    // unbounded exponent. Only a value just below DBL_MIN can round up to it.
+    bool tiny = exp < -1023;
+    if (-1023 == exp)
+    {
+        _xo_args_decimal unbounded = *d;
+        _xo_args_decimal_shift(&unbounded, 53);
+        tiny = _xo_args_decimal_rounded_integer(&unbounded)
+               != ((uint64_t)2 << 52);
+    }
+
+    // Subnormals have fewer bits of mantissa.
+    if (exp < -1022)
+    {
+        _xo_args_decimal_shift(d, exp + 1022);
+        exp = -1022;
+    }
+    if (exp > 1023)
+    {
+        return false;
+    }
+
+    _xo_args_decimal_shift(d, 53);
+    bool const inexact = d->truncated || d->count > d->point;
+    uint64_t mantissa = _xo_args_decimal_rounded_integer(d);
+    if (tiny && inexact)
+    {
+        return false;
+    }
+
+    // Rounding might have added a bit.
+    if (mantissa == ((uint64_t)2 << 52))
+    {
+        mantissa >>= 1;
+        ++exp;
+        if (exp > 1023)
+        {
+            return false;
+        }
+    }
+    // Subnormal (or zero): the biased exponent is 0.
+    if (0 == (mantissa & ((uint64_t)1 << 52)))
+    {
+        *out_bits = mantissa;
+        return true;
+    }
+    *out_bits = ((uint64_t)(exp + 1023) << 52)
+                | (mantissa & (((uint64_t)1 << 52) - 1));
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reads the digits of a decimal number (already validated by the caller) into
+// d. input points after the sign and exponent is the value after 'e'.
+void _xo_args_decimal_init(_xo_args_decimal * const d,
+                           char const * curr,
+                           char const * const end,
+                           int64_t const exponent)
+{
+    d->count = 0;
+    d->point = 0;
+    d->truncated = false;
+    bool saw_point = false;
+    for (; curr != end && ('.' == *curr || (*curr >= '0' && *curr <= '9'));
+         ++curr)
+    {
+        if ('.' == *curr)
+        {
+            saw_point = true;
+            d->point = d->count;
+            continue;
+        }
+        if ('0' == *curr && 0 == d->count)
+        {
+            // Leading zeros only move the decimal point.
+            --d->point;
+            continue;
+        }
+        if (d->count < _XO_ARGS_DECIMAL_CAPACITY)
+        {
+            d->digits[d->count++] = (unsigned char)(*curr - '0');
+        }
+        else if ('0' != *curr)
+        {
+            d->truncated = true;
+        }
+    }
+    if (!saw_point)
+    {
+        d->point = d->count;
+    }
+    // The caller clamps the exponent well inside the range of an int.
+    d->point += (int)exponent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Parses a hexadecimal float: hex digits with an optional '.' and an optional
+// binary exponent. curr points after the "0x".
+bool _xo_args_parse_hex_double(char const * curr,
+                               char const * const end,
+                               uint64_t * const out_bits)
+{
+    uint64_t mantissa = 0;
+    int64_t exponent = 0;
+    int significant = 0; // hex digits held in mantissa
+    bool sticky = false;  // nonzero digits that didn't fit in mantissa
+    bool any_digits = false;
+    bool saw_point = false;
+    for (; curr != end; ++curr)
+    {
+        if ('.' == *curr && !saw_point)
+        {
+            saw_point = true;
+            continue;
+        }
+        unsigned const digit = _xo_args_digit_value(*curr);
+        if (digit >= 16u)
+        {
+            break;
+        }
+        any_digits = true;
+        if (significant < 16 && (0 != mantissa || 0 != digit))
+        {
+            mantissa = (mantissa << 4) | digit;
+            ++significant;
+            exponent -= saw_point ? 4 : 0;
+        }
+        else if (significant < 16)
+        {
+            // A leading zero.
+            exponent -= saw_point ? 4 : 0;
+        }
+        else
+        {
+            sticky = sticky || 0 != digit;
+            exponent += saw_point ? 0 : 4;
+        }
+    }
+    if (!any_digits)
+    {
+        return false;
+    }
+
+    if (curr != end && ('p' == *curr || 'P' == *curr))
+    {
+        ++curr;
+        bool const negative = curr != end && '-' == *curr;
+        if (curr != end && ('-' == *curr || '+' == *curr))
+        {
+            ++curr;
+        }
+        if (curr == end)
+        {
+            return false;
+        }
+        int64_t value = 0;
+        for (; curr != end && *curr >= '0' && *curr <= '9'; ++curr)
+        {
+            value = value < 100000 ? value * 10 + (*curr - '0') : value;
+        }
+        exponent += negative ? -value : value;
+    }
+    if (curr != end)
+    {
+        return false;
+    }
+    if (0 == mantissa)
+    {
+        *out_bits = 0;
+        return true;
+    }
+
+    // Normalize so the value is mantissa * 2^exponent with the top bit set,
+    // which puts the value in [1, 2) * 2^(exponent + 63).
+    int const lz = _xo_args_leading_zeros_64(mantissa);
+    mantissa <<= lz;
+    int64_t const e = exponent - lz + 63;
+    if (e > 1023)
+    {
+        return false;
+    }
+
+    // Keep 53 bits for normals and fewer for subnormals.
+    int64_t const shift = e >= -1022 ? 11 : 11 + (-1022 - e);
+    uint64_t kept = 0;
+    uint64_t rest = mantissa; // the dropped bits
+    uint64_t half = 0;        // the value of half a unit in the last place
+    if (shift < 64)
+    {
+        kept = mantissa >> shift;
+        rest = mantissa & ((((uint64_t)1) << shift) - 1);
+        half = (uint64_t)1 << (shift - 1);
+    }
+    else if (64 == shift)
+    {
+        half = (uint64_t)1 << 63;
+    }
+    bool const inexact = sticky || 0 != rest;
+    bool const round_up =
+        half != 0
+        && (rest > half || (rest == half && (sticky || 1 == (kept & 1))));
+    kept += round_up ? 1u : 0u;
+
+    // Tininess is decided after rounding to 53 bits with an unbounded
+    // exponent, like glibc's strtod.
+    bool tiny = e < -1023;
+    if (-1023 == e)
+    {
+        uint64_t const rest53 = mantissa & 0x7ffu;
+        bool const up53 =
+            rest53 > 0x400u
+            || (rest53 == 0x400u && (sticky || 1 == ((mantissa >> 11) & 1)));
+        tiny = !(up53 && (mantissa >> 11) == ((uint64_t)1 << 53) - 1);
+    }
+    if (tiny && inexact)
+    {
+        return false;
+    }
+
+    if (e < -1022)
+    {
+        // A subnormal. A carry into bit 52 correctly makes it DBL_MIN.
+        *out_bits = kept;
+        return true;
+    }
+    // kept is in [2^52, 2^53]. A carry out of the mantissa bumps the exponent.
+    uint64_t const bits = ((uint64_t)(e + 1022) << 52) + kept;
+    if (bits >= 0x7ff0000000000000ull)
+    {
+        return false;
+    }
+    *out_bits = bits;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns true if the length characters at input equal str, ignoring case.
+bool _xo_args_equals_ignore_case(char const * const input,
+                                 size_t const length,
+                                 char const * const str)
+{
+    size_t i = 0;
+    for (; i < length && '\0' != str[i]; ++i)
+    {
+        if (tolower((unsigned char)input[i]) != str[i])
+        {
+            return false;
+        }
+    }
+    return i == length && '\0' == str[i];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Parses "inf", "infinity", "nan" and "nan(chars)" ignoring case.
+bool _xo_args_parse_special_double(char const * const curr,
+                                   char const * const end,
+                                   uint64_t * const out_bits)
+{
+    size_t const length = (size_t)(end - curr);
+    if (_xo_args_equals_ignore_case(curr, length, "inf")
+        || _xo_args_equals_ignore_case(curr, length, "infinity"))
+    {
+        *out_bits = 0x7ff0000000000000ull;
+        return true;
+    }
+    if (length >= 3 && _xo_args_equals_ignore_case(curr, 3, "nan"))
+    {
+        if (length > 3)
+        {
+            // nan(n-char-sequence)
+            if ('(' != curr[3] || ')' != end[-1] || length < 5)
+            {
+                return false;
+            }
+            // Unlike argument names the sequence may not contain '-', so
+            // _xo_isalnum is not used here.
+            for (char const * c = curr + 4; c != end - 1; ++c)
+            {
+                bool const valid = (*c >= 'A' && *c <= 'Z')
+                                   || (*c >= 'a' && *c <= 'z')
+                                   || (*c >= '0' && *c <= '9') || '_' == *c;
+                if (false == valid)
+                {
+                    return false;
+                }
+            }
+        }
+        *out_bits = 0x7ff8000000000000ull;
+        return true;
+    }
+    return false;
+}
+#endif // !defined(XO_ARGS_USE_STRTOD)
+
+////////////////////////////////////////////////////////////////////////////////
+// Parses the length characters at input as a double. This accepts exactly what
+// strtod accepts in the "C" locale when it consumes the whole input without
+// setting ERANGE, except that leading whitespace is rejected. The result is
+// correctly rounded and does not depend on the current locale.
+//
+// Define XO_ARGS_USE_STRTOD to use strtod instead. In that case input[length]
+// must be the end of the string.
+bool _xo_args_try_parse_double(char const * const input,
+                               size_t const length,
+                               double * out_double)
+{
+#if defined(XO_ARGS_USE_STRTOD)
+    // strtod will discard any leading whitespace.
+    // I would prefer we only accept integers with no leading whitespace so we
+    // can accomplish this by just checking the first character here:
+    if (0 == length || isspace(input[0]))
+    {
+        return false;
+    }
+
+    errno = 0;
+    char * end_ptr;
+    *out_double = strtod(input, &end_ptr);
+
+    if (0 != errno || input + length != end_ptr)
+    {
+        return false;
+    }
+
+    return true;
+#else
+    char const * curr = input;
+    char const * const end = input + length;
+    if (curr == end)
+    {
+        return false;
+    }
+
+    bool const negative = '-' == *curr;
+    if (negative || '+' == *curr)
+    {
+        ++curr;
+    }
+    uint64_t const sign = negative ? 0x8000000000000000ull : 0;
+
+    uint64_t bits = 0;
+    if (end - curr > 2 && '0' == curr[0] && ('x' == curr[1] || 'X' == curr[1])
+        && ('.' == curr[2] || _xo_args_digit_value(curr[2]) < 16u))
+    {
+        if (false == _xo_args_parse_hex_double(curr + 2, end, &bits))
+        {
+            return false;
+        }
+        bits |= sign;
+        memcpy(out_double, &bits, sizeof(bits));
+        return true;
+    }
+    if (curr != end && '.' != *curr && (*curr < '0' || *curr > '9'))
+    {
+        if (false == _xo_args_parse_special_double(curr, end, &bits))
+        {
+            return false;
+        }
+        bits |= sign;
+        memcpy(out_double, &bits, sizeof(bits));
+        return true;
+    }
+
+    // Decimal: up to 19 significant digits are kept in w so that the value is
+    // w * 10^exponent (exactly, unless truncated).
+    char const * const digits_start = curr;
+    uint64_t w = 0;
+    int significant = 0;
+    int64_t exponent = 0;
+    bool truncated = false;
+    bool any_digits = false;
+    for (; curr != end && *curr >= '0' && *curr <= '9'; ++curr)
+    {
+        any_digits = true;
+        unsigned const digit = (unsigned)(*curr - '0');
+        if (significant < 19)
+        {
+            w = w * 10 + digit;
+            significant += (0 != w) ? 1 : 0;
+        }
+        else
+        {
+            ++exponent;
+            truncated = truncated || 0 != digit;
+        }
+    }
+    if (curr != end && '.' == *curr)
+    {
+        ++curr;
+        for (; curr != end && *curr >= '0' && *curr <= '9'; ++curr)
+        {
+            any_digits = true;
+            unsigned const digit = (unsigned)(*curr - '0');
+            if (significant < 19)
+            {
+                w = w * 10 + digit;
+                significant += (0 != w) ? 1 : 0;
+                --exponent;
+            }
+            else
+            {
+                truncated = truncated || 0 != digit;
+            }
+        }
+    }
+    if (!any_digits)
+    {
+        return false;
+    }
+    char const * const digits_end = curr;
+
+    int64_t explicit_exponent = 0;
+    if (curr != end && ('e' == *curr || 'E' == *curr))
+    {
+        ++curr;
+        bool const exponent_negative = curr != end && '-' == *curr;
+        if (curr != end && ('-' == *curr || '+' == *curr))
+        {
+            ++curr;
+        }
+        if (curr == end)
+        {
+            return false;
+        }
+        for (; curr != end && *curr >= '0' && *curr <= '9'; ++curr)
+        {
+            // Anything past this is an overflow or underflow either way.
+            explicit_exponent = explicit_exponent < 100000
+                                    ? explicit_exponent * 10 + (*curr - '0')
+                                    : explicit_exponent;
+        }
+        explicit_exponent = exponent_negative ? -explicit_exponent
+                                              : explicit_exponent;
+    }
+    if (curr != end)
+    {
+        return false;
+    }
+
+    if (0 == w)
+    {
+        bits = 0;
+    }
+    else
+    {
+        int64_t const q = exponent + explicit_exponent;
+        bool found = false;
+        if (q >= _XO_ARGS_POW5_MIN && q <= _XO_ARGS_POW5_MAX)
+        {
+            bits = _xo_args_eisel_lemire((int)q, w);
+            // With truncated digits the value is between w and w + 1; the
+            // result is only certain when both round to the same double.
+            found = !truncated || bits == _xo_args_eisel_lemire((int)q, w + 1);
+        }
+        if (!found)
+        {
+            _xo_args_decimal decimal;
+            _xo_args_decimal_init(
+                &decimal, digits_start, digits_end, explicit_exponent);
+            if (false == _xo_args_decimal_to_double(&decimal, &bits))
+            {
+                return false;
+            }
+        }
+    }
+    bits |= sign;
+    memcpy(out_double, &bits, sizeof(bits));
+    return true;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Integer and double array values can be given as one token with the values
+// separated by commas and/or whitespace, ie: --ids=1,2,3 or --ids "1 2 3".
+bool _xo_args_is_list_delimiter(char const c)
+{
+    return ',' == c || ' ' == c || '\t' == c || '\n' == c || '\r' == c;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// value must not be 0.
+int _xo_args_trailing_zeros_32(unsigned value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(value);
+#else
+    int count = 0;
+    while (0 == (value & 1u))
+    {
+        value >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+#if defined(_XO_ARGS_SSE2)
+////////////////////////////////////////////////////////////////////////////////
+// Returns a mask with bit i set if str[i] is a list delimiter, for the 16
+// bytes at str.
+unsigned _xo_args_delimiter_mask_16(char const * const str)
+{
+    __m128i const chunk = _mm_loadu_si128((__m128i const *)str);
+    __m128i hits = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(','));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')));
+    return (unsigned)_mm_movemask_epi8(hits);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Counts the list delimiters in [curr, end).
+size_t _xo_args_count_delimiters(char const * curr, char const * const end)
+{
+    size_t count = 0;
+#if defined(_XO_ARGS_SSE2)
+    // Only whole 16 byte blocks are loaded so we never read past end.
+    for (; end - curr >= 16; curr += 16)
+    {
+        for (unsigned mask = _xo_args_delimiter_mask_16(curr); 0 != mask;
+             mask &= mask - 1)
+        {
+            ++count;
+        }
+    }
+#endif
+    for (; curr != end; ++curr)
+    {
+        count += _xo_args_is_list_delimiter(*curr) ? 1 : 0;
+    }
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the first list delimiter in [curr, end) or end if there is none.
+char const * _xo_args_find_delimiter(char const * curr, char const * const end)
+{
+#if defined(_XO_ARGS_SSE2)
+    for (; end - curr >= 16; curr += 16)
+    {
+        unsigned const mask = _xo_args_delimiter_mask_16(curr);
+        if (0 != mask)
+        {
+            return curr + _xo_args_trailing_zeros_32(mask);
+        }
+    }
+#endif
+    while (curr != end && false == _xo_args_is_list_delimiter(*curr))
+    {
+        ++curr;
+    }
+    return curr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Appends every value of a delimited list of integers (or doubles) to array.
+// Values are separated by a comma and/or whitespace. Empty values such as in
+// "1,,2" or "1,2," are invalid. Returns false if any value is invalid, in which
+// case nothing is appended.
+bool _xo_args_parse_numeric_list(xo_args_ctx * const context,
+                                 _xo_args_arg_array * const array,
+                                 char const * const str,
+                                 size_t const length,
+                                 bool const doubles)
+{
+    char const * curr = str;
+    char const * const end = str + length;
+
+    // Every delimiter can separate at most one more value. Reserve room for
+    // all of them and parse straight into the array.
+    size_t const value_size = doubles ? sizeof(double) : sizeof(int64_t);
+    size_t const max_values = _xo_args_count_delimiters(curr, end) + 1;
+    _xo_args_arg_array_reserve(
+        context, array, value_size, array->array_size + max_values);
+
+    size_t size = array->array_size;
+    if (1 == max_values)
+    {
+        // The common case of one value per token.
+        bool const parsed =
+            doubles ? _xo_args_try_parse_double(
+                          str, length, &((double *)array->array)[size])
+                    : _xo_args_try_parse_int(
+                          str, length, &((int64_t *)array->array)[size]);
+        array->array_size += parsed ? 1 : 0;
+        return parsed;
+    }
+
+    bool expect_value = true;
+    while (true)
+    {
+        while (curr != end && ',' != *curr
+               && _xo_args_is_list_delimiter(*curr))
+        {
+            ++curr;
+        }
+        if (curr == end)
+        {
+            break;
+        }
+
+        char const * const value_end = _xo_args_find_delimiter(curr, end);
+        size_t const value_length = (size_t)(value_end - curr);
+        if (doubles)
+        {
+            double * const values = (double *)array->array;
+            if (false
+                == _xo_args_try_parse_double(curr, value_length, &values[size]))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            int64_t * const values = (int64_t *)array->array;
+            if (false
+                == _xo_args_try_parse_int(curr, value_length, &values[size]))
+            {
+                return false;
+            }
+        }
+        ++size;
+        curr = value_end;
+
+        while (curr != end && ',' != *curr
+               && _xo_args_is_list_delimiter(*curr))
+        {
+            ++curr;
+        }
+        expect_value = curr != end;
+        if (expect_value)
+        {
+            // Either a comma or the start of the next whitespace separated
+            // value.
+            curr += ',' == *curr ? 1 : 0;
+        }
+    }
+    if (expect_value)
+    {
+        return false;
+    }
+    array->array_size = size;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the string to store as the value of arg for the characters of token
+// from offset onward. With XO_ARGS_CTX_BORROW_ARGV, or if the token is from a
+// response file, this points into the token itself. Otherwise it is a copy in
+// arg->string_copy.
+char const * _xo_args_store_string(xo_args_ctx * const context,
+                                   _xo_args_arg_single * const arg,
+                                   _xo_args_token const * const token,
+                                   size_t const offset)
+{
+    char const * const value = &token->str[offset];
+    if ((context->flags & XO_ARGS_CTX_BORROW_ARGV) || token->from_response_file)
+    {
+        return value;
+    }
+    size_t const value_length = token->length - offset;
+    if (value_length + 1 > arg->string_copy_reserved)
+    {
+        if (NULL != arg->string_copy)
+        {
+            _xo_args_tracked_free(context, arg->string_copy);
+        }
+        arg->string_copy =
+            (char *)_xo_args_tracked_alloc(context, value_length + 1);
+        arg->string_copy_reserved = value_length + 1;
+    }
+    // +1 here will copy the null terminator from value
+    memcpy(arg->string_copy, value, value_length + 1);
+    return arg->string_copy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Prints an error about arg in the form "Error: <before> --name<after>" using
+// the name the user typed (--name or -n).
+void _xo_args_print_arg_error(xo_args_ctx const * const context,
+                              xo_args_arg const * const arg,
+                              bool const is_short,
+                              char const * const before,
+                              char const * const after)
+{
+    context->print("Error: %s%s%s%s",
+                   before,
+                   is_short ? "-" : "--",
+                   is_short ? arg->short_name : arg->name,
+                   after);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Writes the value of every argument that has one to the storage it is bound
+// to. This happens once parsing has succeeded so a failed parse leaves bound
+// storage (and any default value in it) untouched. Arrays could not be written
+// earlier anyway because they can move while values are added.
+void _xo_args_write_bindings(xo_args_ctx const * const context)
+{
+    for (size_t i = 0; i < context->args_size; ++i)
+    {
+        xo_args_arg const * const arg = context->args[i];
+        if (NULL == arg->binding || false == arg->has_value)
+        {
+            continue;
+        }
+        _xo_args_arg_single const * const single =
+            (_xo_args_arg_single const *)arg;
+        _xo_args_arg_array const * const array =
+            (_xo_args_arg_array const *)arg;
+        if (arg->flags & XO_ARGS_TYPE_STRING)
+        {
+            *(char const **)arg->binding = single->value._string;
+        }
+        else if (arg->flags & XO_ARGS_TYPE_SWITCH)
+        {
+            *(bool *)arg->binding = true;
+        }
+        else if (arg->flags & XO_ARGS_TYPE_BOOL)
+        {
+            *(bool *)arg->binding = single->value._bool;
+        }
+        else if (arg->flags & XO_ARGS_TYPE_INT)
+        {
+            *(int64_t *)arg->binding = single->value._int;
+        }
+        else if (arg->flags & XO_ARGS_TYPE_DOUBLE)
+        {
+            *(double *)arg->binding = single->value._double;
+        }
+        else if (arg->flags & XO_ARGS_TYPE_STRING_ARRAY)
+        {
+            *(char const ***)arg->binding = (char const **)array->array;
+        }
+        else if (arg->flags & XO_ARGS_TYPE_INT_ARRAY)
+        {
+            *(int64_t const **)arg->binding = (int64_t const *)array->array;
+        }
+        else if (arg->flags & XO_ARGS_TYPE_DOUBLE_ARRAY)
+        {
+            *(double const **)arg->binding = (double const *)array->array;
+        }
+        else if (arg->flags & XO_ARGS_TYPE_BOOL_ARRAY)
+        {
+            *(bool const **)arg->binding = (bool const *)array->array;
+        }
+        if (_xo_args_arg_flag_is_array(arg->flags))
+        {
+            *arg->binding_count = array->array_size;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The size of one value of an array argument.
+size_t _xo_args_array_value_size(XO_ARGS_ARG_FLAG const flags)
+{
+    if (flags & XO_ARGS_TYPE_INT_ARRAY)
+    {
+        return sizeof(int64_t);
+    }
+    if (flags & XO_ARGS_TYPE_DOUBLE_ARRAY)
+    {
+        return sizeof(double);
+    }
+    if (flags & XO_ARGS_TYPE_BOOL_ARRAY)
+    {
+        return sizeof(bool);
+    }
+    return sizeof(char const *);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Hands the values just added to an array with a value_fn to it and empties
+// the array again. Returns false if value_fn rejected a value.
+bool _xo_args_emit_array_values(_xo_args_arg_array * const array)
+{
+    size_t const value_size = _xo_args_array_value_size(array->base.flags);
+    char const * value = (char const *)array->array;
+    size_t const size = array->array_size;
+    array->array_size = 0;
+    for (size_t i = 0; i < size; ++i, value += value_size)
+    {
+        if (false
+            == array->value_fn(&array->base, value, array->value_fn_user_data))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Parses the characters of token from offset onward as a value of arg. For a
+// single value argument this sets its value, for an array it appends the next
+// value (or the next list of values for integer and double arrays). is_short
+// is true if the user named arg with its short name.
+//
+// Returns false and prints an error if the value is invalid.
+bool _xo_args_parse_value(xo_args_ctx * const context,
+                          xo_args_arg * const arg,
+                          bool const is_short,
+                          _xo_args_token const * const token,
+                          size_t const offset)
+{
+    char const * const value = &token->str[offset];
+    size_t const value_length = token->length - offset;
+    _xo_args_arg_single * const single = (_xo_args_arg_single *)arg;
+    _xo_args_arg_array * const array = (_xo_args_arg_array *)arg;
+
+    bool parsed = true;
+    char const * expected = NULL;
+    if (arg->flags & XO_ARGS_TYPE_STRING)
+    {
+        single->value._string =
+            _xo_args_store_string(context, single, token, offset);
+    }
+    else if (arg->flags & XO_ARGS_TYPE_BOOL)
+    {
+        parsed = _xo_args_try_parse_bool(value, &single->value._bool);
+        expected = "\nexpected true or false.\n";
+    }
+    else if (arg->flags & XO_ARGS_TYPE_INT)
+    {
+        parsed = _xo_args_try_parse_int(
+            value, value_length, &single->value._int);
+        expected = " is not a valid integer or is out of range\n";
+    }
+    else if (arg->flags & XO_ARGS_TYPE_DOUBLE)
+    {
+        parsed = _xo_args_try_parse_double(
+            value, value_length, &single->value._double);
+        expected = " is not a valid number or is out of range\n";
+    }
+    else if (arg->flags & XO_ARGS_TYPE_STRING_ARRAY)
+    {
+        if (NULL != array->value_fn)
+        {
+            // The value only has to outlive the call to value_fn.
+            _xo_args_arg_array_push(
+                context, array, (void *)&value, sizeof(char const *));
+        }
+        else
+        {
+            _xo_args_string_array_push(
+                context, (_xo_args_arg_string_array *)arg, value);
+        }
+    }
+    else if (arg->flags & XO_ARGS_TYPE_INT_ARRAY)
+    {
+        parsed = _xo_args_parse_numeric_list(
+            context, array, value, value_length, false);
+        expected = " is not a valid integer or is out of range\n";
+    }
+    else if (arg->flags & XO_ARGS_TYPE_DOUBLE_ARRAY)
+    {
+        parsed = _xo_args_parse_numeric_list(
+            context, array, value, value_length, true);
+        expected = " is not a valid number or is out of range\n";
+    }
+    else if (arg->flags & XO_ARGS_TYPE_BOOL_ARRAY)
+    {
+        bool parsed_value;
+        parsed = _xo_args_try_parse_bool(value, &parsed_value);
+        if (parsed)
+        {
+            _xo_args_arg_array_push(
+                context, array, &parsed_value, sizeof(bool));
+        }
+        expected = "\nexpected true or false.\n";
+    }
+
+    if (false == parsed)
+    {
+        bool const is_bool =
+            !!(arg->flags & (XO_ARGS_TYPE_BOOL | XO_ARGS_TYPE_BOOL_ARRAY));
+        _xo_args_print_arg_error(context,
+                                 arg,
+                                 is_short,
+                                 is_bool ? "Invalid value provided for "
+                                         : "Value for ",
+                                 expected);
+        return false;
+    }
+    arg->has_value = true;
+    if (_xo_args_arg_flag_is_array(arg->flags) && NULL != array->value_fn
+        && false == _xo_args_emit_array_values(array))
+    {
+        _xo_args_print_arg_error(
+            context, arg, is_short, "Value rejected for ", "\n");
+        return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Advances parsing by one token. The token is either a value of the argument
+// named by an earlier token (context->stream_arg) or names an argument itself.
+//
+// Arrays take the first value that follows their name no matter what it looks
+// like, then continue to take values until a token names a declared argument.
+// For an obtuse example if we want to have the string array foo with the
+// values in order: ['a', '-b', '--foo', 'bar'] then the user could execute
+// the program like so:
+//      program --foo a -b --foo --foo bar
+//
+//      argv[0] "program"   - The program we're running.
+//      argv[1] "--foo"     - This is a named argument so we start parsing
+//                            the following values as an array.
+//      argv[2] "a"         - This is the first value in the foo array.
+//      argv[3] "-b"        - This is the second value in the foo array
+//                            **assuming** there is no variable with the
+//                            short name 'b'.
+//      argv[4] "--foo"     - This is a named argument so we start parsing
+//                            the following values as an array.
+//      argv[5] "--foo"     - This is the third element of the foo array.
+//                            It is not treated as a named argument because
+//                            it is the first value following a named
+//                            argument.
+//      argv[6] "bar"        - This is the fourth element of the foo array.
+//
+// An assigned value ("--foo=a") is the only value taken for that use of the
+// argument.
+//
+// Returns false and prints an error if the token is invalid.
+bool _xo_args_parse_token(xo_args_ctx * const context,
+                          _xo_args_token const * const token)
+{
+    _XO_ARGS_STATS_ADD(context, tokens_scanned, 1);
+    xo_args_arg * const pending = context->stream_arg;
+    if (NULL != pending)
+    {
+        if (0 == context->stream_values
+            || false == _xo_args_ends_array(context, token))
+        {
+            if (false
+                == _xo_args_parse_value(
+                    context, pending, context->stream_short, token, 0))
+            {
+                return false;
+            }
+            ++context->stream_values;
+            if (false == _xo_args_arg_flag_is_array(pending->flags))
+            {
+                context->stream_arg = NULL;
+            }
+            return true;
+        }
+        context->stream_arg = NULL;
+    }
+
+    char const * const argv_arg = token->str;
+    size_t const argv_arg_len = token->length;
+
+    // This is an unexpected case but we will try to ignore it.
+    if (argv_arg_len == 0)
+    {
+        return true;
+    }
+    // All valid variables begin with '-' or '--' so a single
+    // character argument at this position is unexpected
+    // and so is a string not starting with '-'
+    if (argv_arg_len == 1 || argv_arg[0] != '-')
+    {
+        context->print("Error: unknown argument \"%s\"\n", argv_arg);
+        return false;
+    }
+
+    _xo_args_arg_match match;
+    xo_args_arg * const arg = _xo_args_find_arg(context, token, &match);
+    if (NULL == arg)
+    {
+        // the argv_arg looks like an argument but didn't match any
+        // known arguments.
+        context->print("Error: unknown argument \"%s\"\n", argv_arg);
+        return false;
+    }
+
+    // Providing an argument multiple times is an error unless
+    // the type of that argument is an array
+    if (arg->has_value && false == _xo_args_arg_flag_is_array(arg->flags))
+    {
+        context->print("Error: %s was provided multiple times which is "
+                       "unsupported.\n",
+                       argv_arg);
+        return false;
+    }
+
+    if (arg->flags & XO_ARGS_TYPE_SWITCH)
+    {
+        // Reminder: value._bool can be uninitialized for switches because when
+        // no value is set it is implicitly false.
+        arg->has_value = true;
+        return true;
+    }
+
+    bool const is_short =
+        _XO_ARGS_ARG_MATCH_TYPE_SHORT_NAME == match.match_type
+        || _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_SHORT_NAME == match.match_type;
+    if (_XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME == match.match_type
+        || _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_SHORT_NAME == match.match_type)
+    {
+        // The value begins after the assignment operator which was found when
+        // the token was preprocessed.
+        return _xo_args_parse_value(
+            context, arg, is_short, token, token->assign + 1);
+    }
+
+    context->stream_arg = arg;
+    context->stream_short = is_short;
+    context->stream_values = 0;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// A thread started by _xo_args_thread_start.
+typedef struct _xo_args_thread
+{
+    void (*fn)(void * data);
+    void * data;
+#if defined(_XO_ARGS_WIN32_THREADS)
+    HANDLE handle;
+#elif defined(_XO_ARGS_PTHREADS)
+    pthread_t handle;
+#endif
+    bool started; // fn runs on a thread of its own
+} _xo_args_thread;
+
+#if defined(_XO_ARGS_WIN32_THREADS)
+////////////////////////////////////////////////////////////////////////////////
+DWORD WINAPI _xo_args_thread_main(LPVOID thread)
+{
+    _xo_args_thread * const self = (_xo_args_thread *)thread;
+    self->fn(self->data);
+    return 0;
+}
+#elif defined(_XO_ARGS_PTHREADS)
+////////////////////////////////////////////////////////////////////////////////
+void * _xo_args_thread_main(void * thread)
+{
+    _xo_args_thread * const self = (_xo_args_thread *)thread;
+    self->fn(self->data);
+    return NULL;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// The number of threads to use when the caller asks for 0.
+size_t _xo_args_processor_count(void)
+{
+#if defined(_XO_ARGS_WIN32_THREADS)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#elif defined(_XO_ARGS_PTHREADS) && defined(_SC_NPROCESSORS_ONLN)
+    long const count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+#else
+    return 1;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Runs fn(data) on a thread of its own. Returns false if the thread could not
+// be created (or the platform has no threads), in which case the caller has to
+// do the work some other way. thread must not move until it is joined.
+bool _xo_args_thread_start(_xo_args_thread * const thread,
+                           void (*fn)(void * data),
+                           void * const data)
+{
+    thread->fn = fn;
+    thread->data = data;
+#if defined(_XO_ARGS_WIN32_THREADS)
+    thread->handle =
+        CreateThread(NULL, 0, _xo_args_thread_main, thread, 0, NULL);
+    thread->started = NULL != thread->handle;
+#elif defined(_XO_ARGS_PTHREADS)
+    thread->started =
+        0
+        == pthread_create(&thread->handle, NULL, _xo_args_thread_main, thread);
+#else
+    thread->started = false;
+#endif
+    return thread->started;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Waits for a thread started by _xo_args_thread_start. Does nothing if it was
+// not started.
+void _xo_args_thread_join(_xo_args_thread * const thread)
+{
+    if (false == thread->started)
+    {
+        return;
+    }
+#if defined(_XO_ARGS_WIN32_THREADS)
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#elif defined(_XO_ARGS_PTHREADS)
+    pthread_join(thread->handle, NULL);
+#endif
+    thread->started = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// One thread's share of a run of integer or double array values. See
+// _xo_args_parse_value_run.
+typedef struct _xo_args_value_range
+{
+    _xo_args_token const * tokens;
+    size_t count;
+    void * values; // where the value of tokens[0] is written
+    bool doubles;
+    size_t converted; // the tokens converted before one that could not be
+    _xo_args_thread thread;
+} _xo_args_value_range;
+
+////////////////////////////////////////////////////////////////////////////////
+// Converts the tokens of an _xo_args_value_range in order, stopping at the
+// first token that is invalid or holds a list of values.
+void _xo_args_convert_values(void * const data)
+{
+    _xo_args_value_range * const range = (_xo_args_value_range *)data;
+    size_t i = 0;
+    for (; i < range->count; ++i)
+    {
+        _xo_args_token const * const token = &range->tokens[i];
+        char const * const end = token->str + token->length;
+        if (end != _xo_args_find_delimiter(token->str, end))
+        {
+            break;
+        }
+        void * const value =
+            (char *)range->values
+            + i * (range->doubles ? sizeof(double) : sizeof(int64_t));
+        bool const parsed =
+            range->doubles
+                ? _xo_args_try_parse_double(
+                      token->str, token->length, (double *)value)
+                : _xo_args_try_parse_int(
+                      token->str, token->length, (int64_t *)value);
+        if (false == parsed)
+        {
+            break;
+        }
+    }
+    range->converted = i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Converts the run of values starting at context->tokens[first] on several
+// threads if context->stream_arg is an integer or double array that was just
+// named and the run holds at least two shares of XO_ARGS_PARALLEL_VALUES. Each
+// thread writes its share straight into the array. Returns the number of
+// tokens converted, which the caller skips.
+//
+// Conversion stops before the first token that is invalid or holds a list of
+// values. That token and the rest of the run are left to _xo_args_parse_token
+// so errors are reported exactly as if every value was parsed in turn.
+size_t _xo_args_parse_value_run(xo_args_ctx * const context,
+                                size_t const first)
+{
+    xo_args_arg * const arg = context->stream_arg;
+    XO_ARGS_ARG_FLAG const numeric_arrays =
+        (XO_ARGS_ARG_FLAG)(XO_ARGS_TYPE_INT_ARRAY | XO_ARGS_TYPE_DOUBLE_ARRAY);
+    if (NULL == arg || 0 != context->stream_values
+        || 0 == (arg->flags & numeric_arrays)
+        || context->tokens_size - first < 2 * XO_ARGS_PARALLEL_VALUES)
+    {
+        return 0;
+    }
+    _xo_args_arg_array * const array = (_xo_args_arg_array *)arg;
+    size_t thread_count = 0 != context->value_threads
+                              ? context->value_threads
+                              : _xo_args_processor_count();
+    if (NULL != array->value_fn || thread_count < 2)
+    {
+        return 0;
+    }
+
+    // The first value after the array's name never ends it.
+    size_t end = first + 1;
+    while (end < context->tokens_size
+           && false == _xo_args_ends_array(context, &context->tokens[end]))
+    {
+        ++end;
+    }
+    size_t const count = end - first;
+    thread_count = min(thread_count, count / XO_ARGS_PARALLEL_VALUES);
+    if (thread_count < 2)
+    {
+        return 0;
+    }
+
+    size_t const value_size = _xo_args_array_value_size(arg->flags);
+    _xo_args_arg_array_reserve(
+        context, array, value_size, array->array_size + count);
+    _xo_args_value_range * const ranges = (_xo_args_value_range *)
+        _xo_args_tracked_alloc(context, sizeof(*ranges) * thread_count);
+    size_t const share = count / thread_count;
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        _xo_args_value_range * const range = &ranges[i];
+        size_t const offset = i * share;
+        memset(range, 0, sizeof(*range));
+        range->tokens = &context->tokens[first + offset];
+        range->count = i + 1 == thread_count ? count - offset : share;
+        range->values =
+            (char *)array->array + (array->array_size + offset) * value_size;
+        range->doubles = !!(arg->flags & XO_ARGS_TYPE_DOUBLE_ARRAY);
+    }
+
+    // The calling thread converts the first share and any share a thread could
+    // not be started for.
+    for (size_t i = 1; i < thread_count; ++i)
+    {
+        _xo_args_thread_start(
+            &ranges[i].thread, _xo_args_convert_values, &ranges[i]);
+    }
+    _xo_args_convert_values(&ranges[0]);
+    for (size_t i = 1; i < thread_count; ++i)
+    {
+        if (ranges[i].thread.started)
+        {
+            _xo_args_thread_join(&ranges[i].thread);
+        }
+        else
+        {
+            _xo_args_convert_values(&ranges[i]);
+        }
+    }
+
+    // Only values before the first token that stopped a share count.
+    size_t converted = 0;
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        converted += ranges[i].converted;
+        if (ranges[i].converted != ranges[i].count)
+        {
+            break;
+        }
+    }
+    _xo_args_tracked_free(context, ranges);
+
+    array->array_size += converted;
+    context->stream_values += converted;
+    if (0 != converted)
+    {
+        arg->has_value = true;
+    }
+    _XO_ARGS_STATS_ADD(context, tokens_scanned, converted);
+    return converted;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Parses context->tokens from first onward. Returns false on the first invalid
+// token.
+bool _xo_args_parse_tokens(xo_args_ctx * const context, size_t const first)
+{
+    for (size_t i = first; i < context->tokens_size; ++i)
+    {
+        i += _xo_args_parse_value_run(context, i);
+        if (i == context->tokens_size)
+        {
+            break;
+        }
+        if (false == _xo_args_parse_token(context, &context->tokens[i]))
+        {
+            _xo_print_try_help(context);
+            context->parse_failed = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Counts the value in token (from offset onward) towards the presize of array.
+void _xo_args_presize_count(_xo_args_arg_array * const array,
+                            _xo_args_token const * const token,
+                            size_t const offset)
+{
+    ++array->presize_values;
+    if (array->base.flags & XO_ARGS_TYPE_STRING_ARRAY)
+    {
+        ((_xo_args_arg_string_array *)array)->presize_bytes +=
+            token->length - offset + 1;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reserves room in every array argument for all of the values the tokens from
+// first onward can give it so parsing them never grows an array. The tokens
+// are walked with the same rules as _xo_args_parse_token but nothing is
+// parsed: a token that could be a value of an array is counted as one. A
+// delimited list of numbers counts as one value too, so the few arrays given
+// lists may still grow while parsing.
+void _xo_args_presize_arrays(xo_args_ctx * const context, size_t const first)
+{
+    bool any_array = false;
+    for (size_t i = 0; i < context->args_size; ++i)
+    {
+        if (_xo_args_arg_flag_is_array(context->args[i]->flags))
+        {
+            any_array = true;
+            break;
+        }
+    }
+    if (false == any_array)
+    {
+        return;
+    }
+
+    _xo_args_arg_array * current = NULL;
+    size_t current_values = 0;
+    bool skip_value = false;
+    for (size_t i = first; i < context->tokens_size; ++i)
+    {
+        _xo_args_token const * const token = &context->tokens[i];
+        if (skip_value)
+        {
+            skip_value = false;
+            continue;
+        }
+
+        // Only a token starting with '-' can end an array and the first value
+        // after the array's name never does.
+        _xo_args_arg_match match;
+        xo_args_arg * const arg =
+            (0 == token->dashes || (NULL != current && 0 == current_values))
+                ? NULL
+                : _xo_args_find_arg(context, token, &match);
+        if (NULL == arg)
+        {
+            if (NULL != current)
+            {
+                _xo_args_presize_count(current, token, 0);
+                ++current_values;
+            }
+            continue;
+        }
+
+        current = NULL;
+        if (arg->flags & XO_ARGS_TYPE_SWITCH)
+        {
+            continue;
+        }
+        bool const assigned =
+            _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_NAME == match.match_type
+            || _XO_ARGS_ARG_MATCH_TYPE_ASSIGN_SHORT_NAME == match.match_type;
+        if (false == _xo_args_arg_flag_is_array(arg->flags))
+        {
+            skip_value = false == assigned;
+        }
+        else if (assigned)
+        {
+            _xo_args_presize_count(
+                (_xo_args_arg_array *)arg, token, token->assign + 1);
+        }
+        else
+        {
+            current = (_xo_args_arg_array *)arg;
+            current_values = 0;
+        }
+    }
+
+    for (size_t i = 0; i < context->args_size; ++i)
+    {
+        xo_args_arg * const arg = context->args[i];
+        if (false == _xo_args_arg_flag_is_array(arg->flags))
+        {
+            continue;
+        }
+        _xo_args_arg_array * const array = (_xo_args_arg_array *)arg;
+        if (0 == array->presize_values || NULL != array->value_fn)
+        {
+            // Values given to a value_fn are not kept so need no room.
+            array->presize_values = 0;
+            if (arg->flags & XO_ARGS_TYPE_STRING_ARRAY)
+            {
+                ((_xo_args_arg_string_array *)arg)->presize_bytes = 0;
+            }
+            continue;
+        }
+        _xo_args_arg_array_reserve(context,
+                                   array,
+                                   _xo_args_array_value_size(arg->flags),
+                                   array->array_size + array->presize_values);
+        array->presize_values = 0;
+
+        if (0 == (arg->flags & XO_ARGS_TYPE_STRING_ARRAY))
+        {
+            continue;
+        }
+        _xo_args_arg_string_array * const strings =
+            (_xo_args_arg_string_array *)arg;
+        if (0 == (context->flags & XO_ARGS_CTX_BORROW_ARGV))
+        {
+            _xo_args_string_array_reserve_tables(context, strings);
+            _xo_args_string_array_reserve_blob(
+                context, strings, strings->blob_size + strings->presize_bytes);
+        }
+        strings->presize_bytes = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Declares the built-in arguments, indexes every argument and caches the help
+// text if the context asks for it. This is the part of _xo_args_begin that
+// xo_args_freeze_schema does too.
+void _xo_args_prepare(xo_args_ctx * const context)
+{
+    // After xo_args_reset_values (or in a context created from a schema) the
+    // built-in arguments already exist.
+    if (NULL == context->help_arg)
+    {
+        context->help_arg = xo_args_declare_arg(context,
+                                                "help",
+                                                "h",
+                                                NULL,
+                                                "show this message",
+                                                XO_ARGS_TYPE_SWITCH);
+    }
+    if (NULL != context->app_version && NULL == context->version_arg)
+    {
+        context->version_arg = xo_args_declare_arg(context,
+                                                   "version",
+                                                   "v",
+                                                   NULL,
+                                                   "shows the program version",
+                                                   XO_ARGS_TYPE_SWITCH);
+    }
+
+    // The index and help text are kept until another argument is declared.
+    if (context->indexed_args != context->args_size)
+    {
+        _xo_args_index_build(context, NULL);
+        context->indexed_args = context->args_size;
+    }
+    if ((context->flags & XO_ARGS_CTX_CACHE_HELP) && NULL == context->help_text)
+    {
+        _xo_args_cache_help(context);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns false if context is a frozen schema, which parsing would modify.
+// Checked before the parsing functions touch any of the context's state.
+bool _xo_args_can_parse(xo_args_ctx const * const context)
+{
+    if (context->frozen)
+    {
+        XO_ARGS_ASSERT(false == context->frozen,
+                       "a frozen schema can not parse arguments.");
+        return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The start of parsing shared by xo_args_submit and xo_args_feed: prepares the
+// arguments and parses the context's argv.
+bool _xo_args_begin(xo_args_ctx * const context)
+{
+    _xo_args_prepare(context);
+    context->parse_started = true;
+
+    if (false == _xo_args_tokenize_argv(context))
+    {
+        context->parse_failed = true;
+        return false;
+    }
+    // argv[0] is the program
+    _xo_args_presize_arrays(context, 1);
+    return _xo_args_parse_tokens(context, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The end of parsing shared by xo_args_submit and xo_args_finish: checks that
+// every argument is complete and handles --help and --version.
+bool _xo_args_end(xo_args_ctx * const context)
+{
+    if (NULL != context->stream_arg && 0 == context->stream_values)
+    {
+        _xo_args_print_arg_error(context,
+                                 context->stream_arg,
+                                 context->stream_short,
+                                 "No value provided for ",
+                                 "\n");
+        _xo_print_try_help(context);
+        return false;
+    }
+    context->stream_arg = NULL;
+
+    bool help = false;
+    if (xo_args_try_get_bool(context->help_arg, &help) && true == help)
+    {
+        xo_args_print_help(context);
+        return false;
+    }
+
+    bool version = false;
+    if ((NULL != context->app_version)
+        && xo_args_try_get_bool(context->version_arg, &version)
+        && (true == version))
+    {
+        xo_args_print_help(context);
+        return false;
+    }
+
+    for (size_t i = 0; i < context->args_size; ++i)
+    {
+        xo_args_arg const * const arg = context->args[i];
+        if ((arg->flags & XO_ARGS_ARG_REQUIRED) && (false == arg->has_value))
+        {
+            if (NULL == arg->short_name)
+            {
+                context->print("Error: argument --%s is required.\n",
+                               arg->name);
+            }
+            else
+            {
+                context->print("Error: argument --%s / -%s is required.\n",
+                               arg->name,
+                               arg->short_name);
+            }
+            _xo_print_try_help(context);
+            return false;
+        }
+    }
+
+    _xo_args_write_bindings(context);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool xo_args_submit(xo_args_ctx * const context)
+{
+    if (NULL == context)
+    {
+        XO_ARGS_ASSERT(NULL != context, "xo_args_ctx must not be null here.");
+        return false;
+    }
+    if (false == _xo_args_can_parse(context))
+    {
+        return false;
+    }
+    if (context->parse_started)
+    {
+        XO_ARGS_ASSERT(false == context->parse_started,
+                       "arguments have already been submitted or fed.");
+        return false;
+    }
+    _XO_ARGS_STATS_START();
+    bool const valid = _xo_args_begin(context) && _xo_args_end(context);
+    context->parse_finished = true;
+    _XO_ARGS_STATS_STOP(context, submit_ns);
+    return valid;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool xo_args_feed(xo_args_ctx * const context, char const * const token)
+{
+    if (NULL == context)
+    {
+        XO_ARGS_ASSERT(NULL != context, "xo_args_ctx must not be null here.");
+        return false;
+    }
+    if (NULL == token)
+    {
+        XO_ARGS_ASSERT(NULL != token, "token must not be null here.");
+        return false;
+    }
+    if (false == _xo_args_can_parse(context))
+    {
+        return false;
+    }
+    if (context->parse_finished)
+    {
+        XO_ARGS_ASSERT(false == context->parse_finished,
+                       "xo_args_feed was called after parsing finished.");
+        return false;
+    }
+    if (context->parse_failed)
+    {
+        return false;
+    }
+    _XO_ARGS_STATS_START();
+    if (false == context->parse_started && false == _xo_args_begin(context))
+    {
+        _XO_ARGS_STATS_STOP(context, submit_ns);
+        return false;
+    }
+
+    // context->tokens only holds the tokens of this call (more than one if
+    // token names a response file). They are parsed and then forgotten.
+    context->tokens_size = 0;
+    bool parsed = false;
+    if (_xo_args_append_token(context, token, false, 0))
+    {
+        parsed = _xo_args_parse_tokens(context, 0);
+    }
+    else
+    {
+        context->parse_failed = true;
+    }
+    _XO_ARGS_STATS_STOP(context, submit_ns);
+    return parsed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool xo_args_finish(xo_args_ctx * const context)
+{
+    if (NULL == context)
+    {
+        XO_ARGS_ASSERT(NULL != context, "xo_args_ctx must not be null here.");
+        return false;
+    }
+    if (false == _xo_args_can_parse(context))
+    {
+        return false;
+    }
+    if (context->parse_finished)
+    {
+        XO_ARGS_ASSERT(false == context->parse_finished,
+                       "xo_args_finish was called more than once.");
+        return false;
+    }
+    _XO_ARGS_STATS_START();
+    if (false == context->parse_started && false == _xo_args_begin(context))
+    {
+        context->parse_finished = true;
+        _XO_ARGS_STATS_STOP(context, submit_ns);
+        return false;
+    }
+    context->parse_finished = true;
+    bool const valid = false == context->parse_failed && _xo_args_end(context);
+    _XO_ARGS_STATS_STOP(context, submit_ns);
+    return valid;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_reset_values(xo_args_ctx * const context,
+                          xo_argc_t const argc,
+                          xo_argv_t const argv)
+{
+    if (NULL == context)
+    {
+        XO_ARGS_ASSERT(NULL != context, "xo_args_ctx must not be null here.");
+        return;
+    }
+    if (NULL == argv || argc < 1)
+    {
+        XO_ARGS_ASSERT(NULL != argv && argc >= 1,
+                       "argv must hold at least the program.");
+        return;
+    }
+    if (false == _xo_args_can_parse(context))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < context->args_size; ++i)
+    {
+        xo_args_arg * const arg = context->args[i];
+        arg->has_value = false;
+        if (arg->flags & XO_ARGS_TYPE_STRING_ARRAY)
+        {
+            ((_xo_args_arg_string_array *)arg)->blob_size = 0;
+        }
+        if (_xo_args_arg_flag_is_array(arg->flags))
+        {
+            ((_xo_args_arg_array *)arg)->array_size = 0;
+        }
+    }
+
+    _xo_args_release_response_files(context);
+    context->argc = argc;
+    context->argv = argv;
+    context->tokens_size = 0;
+    context->stream_arg = NULL;
+    context->stream_values = 0;
+    context->stream_short = false;
+    context->parse_started = false;
+    context->parse_failed = false;
+    context->parse_finished = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_destroy_ctx(xo_args_ctx * context)
+{
+    if (NULL == context)
+    {
+        XO_ARGS_ASSERT(NULL != context, "xo_args_ctx must not be null here.");
+        return;
+    }
+    _xo_args_release_response_files(context);
+
+    // There is no need to use the tracked delete here.
+    // It performs extra work such as swapping elements which is intended to
+    // keep the list valid after freeing each element. We don't care about that.
+    for (size_t i = 0; i < context->allocations_size; ++i)
+    {
+        context->free(context->allocations[i]);
+    }
+    if (NULL != context->allocations)
+    {
+        context->free(context->allocations);
+    }
+
+    _xo_args_arena_chunk * chunk = context->arena;
+    while (NULL != chunk)
+    {
+        _xo_args_arena_chunk * const next = chunk->next;
+        context->free(chunk);
+        chunk = next;
+    }
+    context->free(context);
+}
+
+#if defined(XO_ARGS_STATS)
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_get_stats(xo_args_ctx const * const context,
+                       xo_args_stats * const out_stats)
+{
+    if (NULL == context || NULL == out_stats)
+    {
+        XO_ARGS_ASSERT(NULL != context && NULL != out_stats,
+                       "xo_args_ctx and out_stats must not be null here.");
+        return;
+    }
+    *out_stats = context->stats;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Checks the name, short name and flags of an argument declaration. Returns
+// false (after asserting) if the declaration is invalid.
+bool _xo_args_check_declaration(char const * const name,
+                                char const * const short_name,
+                                XO_ARGS_ARG_FLAG const flags)
+{
+    if (NULL == name)
+    {
+        XO_ARGS_ASSERT(NULL != name, "name must not be null here");
+        return false;
+    }
+
+    size_t const name_len = strlen(name);
+    XO_ARGS_ASSERT(name_len != 0,
+                   "name must be a valid string with a length >= 1");
+
+    size_t const short_name_len = NULL != short_name ? strlen(short_name) : 0;
+    XO_ARGS_ASSERT(short_name == NULL || short_name_len != 0,
+                   "if a short name is provided it must have a length >= 1");
+
+    bool const name_is_alnum = _xo_isalnum_str(name, name + name_len);
+    if (false == name_is_alnum)
+    {
+        XO_ARGS_ASSERT(true == name_is_alnum,
+                       "argument names must be alphanumeric");
+        return false;
+    }
+
+    if (short_name_len > 0)
+    {
+        bool const short_name_is_alnum =
+            _xo_isalnum_str(short_name, short_name + short_name_len);
+        if (false == short_name_is_alnum)
+        {
+            XO_ARGS_ASSERT(true == short_name_is_alnum,
+                           "argument short names must be alphanumeric");
+            return false;
+        }
+    }
+
+    {
+        // Extract the type from the provided flags and count the set bits
+        // if there is more than one type bit set: the argument declaration is
+        // invalid.
+        XO_ARGS_ARG_FLAG const type_flag =
+            (XO_ARGS_ARG_FLAG)(flags & _XO_ARGS_ALL_TYPES);
+        size_t type_flag_temp = type_flag;
+        size_t bits = 0;
+        for (; type_flag_temp; ++bits)
+        {
+            type_flag_temp &= type_flag_temp - 1;
+        }
+
+        if (bits > 1)
+        {
+            XO_ARGS_ASSERT(bits <= 1,
+                           "arguments must only have one or zero types set");
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The flags an argument is declared with. If no type flag is set the type is
+// string.
+XO_ARGS_ARG_FLAG _xo_args_declared_flags(XO_ARGS_ARG_FLAG const flags)
+{
+    XO_ARGS_ARG_FLAG result =
+        (XO_ARGS_ARG_FLAG)((_XO_ARGS_ALL_TYPES & flags)
+                               ? flags
+                               : flags | XO_ARGS_TYPE_STRING);
+
+    // A required switch doesn't make much sense so we will just assume the dev
+    // meant the switch should behave normally (optionally).
+    if ((XO_ARGS_TYPE_SWITCH | XO_ARGS_ARG_REQUIRED)
+        == (flags & (XO_ARGS_TYPE_SWITCH | XO_ARGS_ARG_REQUIRED)))
+    {
+        result = (XO_ARGS_ARG_FLAG)(result & ~XO_ARGS_ARG_REQUIRED);
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The size of the concrete argument structure for flags (as returned by
+// _xo_args_declared_flags).
+size_t _xo_args_arg_struct_size(XO_ARGS_ARG_FLAG const flags)
+{
+    if (flags & XO_ARGS_TYPE_STRING_ARRAY)
+    {
+        return sizeof(_xo_args_arg_string_array);
+    }
+    if (_xo_args_arg_flag_is_array(flags))
+    {
+        return sizeof(_xo_args_arg_array);
+    }
+    return sizeof(_xo_args_arg_single);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Gives arg no value and no memory of its own for values.
+void _xo_args_clear_arg_storage(xo_args_arg * const arg,
+                                XO_ARGS_ARG_FLAG const flags)
+{
+    if (flags & XO_ARGS_TYPE_STRING_ARRAY)
+    {
+        _xo_args_arg_string_array * const arg_string_array =
+            (_xo_args_arg_string_array *)arg;
+        // We will allocate the blob and tables on first push
+        arg_string_array->blob = NULL;
+        arg_string_array->blob_reserved = 0;
+        arg_string_array->blob_size = 0;
+        arg_string_array->offsets = NULL;
+        arg_string_array->lengths = NULL;
+        arg_string_array->table_reserved = 0;
+        arg_string_array->presize_bytes = 0;
+    }
+    if (_xo_args_arg_flag_is_array(flags))
+    {
+        _xo_args_arg_array * const arg_array = (_xo_args_arg_array *)arg;
+        // We will allocate the array on first push
+        arg_array->array_size = 0;
+        arg_array->array_reserved = 0;
+        arg_array->array = NULL;
+        arg_array->presize_values = 0;
+    }
+    else
+    {
+        _xo_args_arg_single * const arg_single = (_xo_args_arg_single *)arg;
+        arg_single->string_copy = NULL;
+        arg_single->string_copy_reserved = 0;
+    }
+    arg->has_value = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Initializes the concrete argument at arg (_xo_args_arg_struct_size(flags)
+// bytes). The strings are stored as given: the caller decides whether they are
+// copies or borrowed.
+void _xo_args_init_arg(xo_args_arg * const arg,
+                       char const * const name,
+                       char const * const short_name,
+                       char const * const value_tip,
+                       char const * const description,
+                       XO_ARGS_ARG_FLAG const flags)
+{
+    _xo_args_clear_arg_storage(arg, flags);
+    if (_xo_args_arg_flag_is_array(flags))
+    {
+        _xo_args_arg_array * const arg_array = (_xo_args_arg_array *)arg;
+        arg_array->capacity_hint = 0;
+        arg_array->value_fn = NULL;
+        arg_array->value_fn_user_data = NULL;
+    }
+
+    arg->flags = flags;
+    arg->binding = NULL;
+    arg->binding_count = NULL;
+
+    arg->name = name;
+    arg->name_length = strlen(name);
+
+    arg->short_name = short_name;
+    arg->short_name_length = NULL != short_name ? strlen(short_name) : 0;
+
+    arg->description = description;
+    arg->description_length = NULL != description ? strlen(description) : 0;
+
+    if (NULL != value_tip)
+    {
+        arg->value_tip = value_tip;
+        arg->value_tip_length = strlen(value_tip);
+    }
+    else if (arg->flags & XO_ARGS_TYPE_STRING)
+    {
+        arg->value_tip = "TEXT";
+        arg->value_tip_length = 4;
+    }
+    else if (arg->flags & XO_ARGS_TYPE_INT)
+    {
+        arg->value_tip = "INTEGER";
+        arg->value_tip_length = 7;
+    }
+    else if (arg->flags & XO_ARGS_TYPE_DOUBLE)
+    {
+        arg->value_tip = "NUMBER";
+        arg->value_tip_length = 6;
+    }
+    else if (arg->flags & XO_ARGS_TYPE_BOOL)
+    {
+        arg->value_tip = "TRUE|FALSE";
+        arg->value_tip_length = 10;
+    }
+    else if (arg->flags & XO_ARGS_TYPE_STRING_ARRAY)
+    {
+        arg->value_tip = "[TEXT]...";
+        arg->value_tip_length = 9;
+    }
+    else if (arg->flags & XO_ARGS_TYPE_INT_ARRAY)
+    {
+        arg->value_tip = "[INTEGER]...";
+        arg->value_tip_length = 12;
+    }
+    else if (arg->flags & XO_ARGS_TYPE_DOUBLE_ARRAY)
+    {
+        arg->value_tip = "[NUMBER]...";
+        arg->value_tip_length = 11;
+    }
+    else if (arg->flags & XO_ARGS_TYPE_BOOL_ARRAY)
+    {
+        arg->value_tip = "[TRUE|FALSE]...";
+        arg->value_tip_length = 15;
+    }
+    else
+    {
+        // Switches don't get a tip because they don't have a value that follows
+        arg->value_tip = NULL;
+        arg->value_tip_length = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns a tracked copy of str or NULL if str is NULL.
+char const * _xo_args_copy_string(xo_args_ctx * const context,
+                                  char const * const str)
+{
+    if (NULL == str)
+    {
+        return NULL;
+    }
+    size_t const length = strlen(str);
+    char * const buff = (char *)_xo_args_tracked_alloc(context, length + 1);
+    memcpy(buff, str, length + 1);
+    return buff;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Makes sure context->args has room for count more arguments.
+void _xo_args_reserve_args(xo_args_ctx * const context, size_t const count)
+{
+    size_t reserved = context->args_reserved;
+    while (reserved < context->args_size + count)
+    {
+        reserved *= 2;
+    }
+    if (reserved != context->args_reserved)
+    {
+        context->args_reserved = reserved;
+        context->args = (xo_args_arg **)_xo_args_tracked_realloc(
+            context, context->args, reserved * sizeof(xo_args_arg *));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Arguments can be declared before parsing begins or after it has finished.
+bool _xo_args_can_declare(xo_args_ctx const * const context)
+{
+    if (context->frozen || NULL != context->schema)
+    {
+        XO_ARGS_ASSERT(false == context->frozen && NULL == context->schema,
+                       "arguments can not be declared on a frozen schema or a "
+                       "context created from one");
+        return false;
+    }
+    if (context->parse_started && false == context->parse_finished)
+    {
+        XO_ARGS_ASSERT(false == context->parse_started,
+                       "arguments can not be declared between xo_args_feed "
+                       "and xo_args_finish");
+        return false;
+    }
+    return true;
+}
 
-            buff = (char *)_xo_args_tracked_alloc(context, next_value_len + 1);
-            memcpy(buff, next_value, next_value_len + 1);
-            _xo_args_arg_array_push(
-                context, array, (void *)&buff, sizeof(char *));
-            *argv_index = next_index;
-        }
-        return true;
+////////////////////////////////////////////////////////////////////////////////
+xo_args_arg * xo_args_declare_arg(xo_args_ctx * const context,
+                                  char const * const name,
+                                  char const * const short_name,
+                                  char const * const value_tip,
+                                  char const * const description,
+                                  XO_ARGS_ARG_FLAG const flags)
+{
+    if (NULL == context)
+    {
+        XO_ARGS_ASSERT(NULL != context, "xo_args_ctx must not be null here.");
+        return NULL;
     }
-    else if (arg->flags & XO_ARGS_TYPE_INT_ARRAY)
+    if (false == _xo_args_can_declare(context)
+        || false == _xo_args_check_declaration(name, short_name, flags))
     {
-        char const * argv_name = context->argv[*argv_index];
-        _xo_args_arg_array * const array = (_xo_args_arg_array *)arg;
-        size_t next_index = (*argv_index) + 1;
-        if (next_index >= (size_t)context->argc)
-        {
-            context->print("Error: No value provided for %s\n",
-                           context->argv[*argv_index]);
-            return false;
-        }
+        return NULL;
+    }
+    _XO_ARGS_STATS_START();
 
-        char const * next_value = context->argv[next_index];
-        int64_t parsed_value;
+    size_t const name_len = strlen(name);
+    size_t const short_name_len = NULL != short_name ? strlen(short_name) : 0;
 
-        if (true
-            == _xo_args_try_parse_int(context->argv[next_index], &parsed_value))
+    // Look for conflicts with existing arguments first.
+    for (size_t i = 0; i < context->args_size; ++i)
+    {
+        xo_args_arg * const existing_arg = context->args[i];
+        if ((name_len == existing_arg->name_length)
+            && (0 == strcmp(existing_arg->name, name)))
         {
-            _xo_args_arg_array_push(
-                context, array, &parsed_value, sizeof(int64_t));
-            arg->has_value = true;
-            *argv_index = next_index;
+            context->print("xo-args error: %s argument name conflict. name:"
+                           " %s\n",
+                           __func__,
+                           name);
+            return NULL;
         }
-        else
+        if ((NULL != short_name) && (NULL != existing_arg->short_name)
+            && (short_name_len == existing_arg->short_name_length)
+            && (0 == strcmp(existing_arg->short_name, short_name)))
         {
-            context->print("Error: Value for %s is not a valid integer or is "
-                           "out of range\n",
-                           argv_name);
-            return false;
+            context->print("xo-args error: %s argument short_name conflict."
+                           " short_name: %s\n",
+                           __func__,
+                           short_name);
+            return NULL;
         }
+    }
 
-        // Consume every following value until we see a valid argument
-        for (++next_index; next_index < (size_t)context->argc; ++next_index)
-        {
-            next_value = context->argv[next_index];
-
-            for (size_t j = 0; j < context->args_size; ++j)
-            {
-                xo_args_arg const * const other_arg = context->args[j];
-                if (_xo_args_arg_matches_input(other_arg, next_value, NULL))
-                {
-                    // The next argument is a valid arg so don't parse
-                    // that as a value of this string array
-                    return true;
-                }
-            }
-
-            if (true
-                == _xo_args_try_parse_int(context->argv[next_index],
-                                          &parsed_value))
-            {
-                _xo_args_arg_array_push(
-                    context, array, &parsed_value, sizeof(int64_t));
-                arg->has_value = true;
-                *argv_index = next_index;
-            }
-            else
-            {
-                context->print(
-                    "Error: Value for %s is not a valid integer or is "
-                    "out of range\n",
-                    argv_name);
-                return false;
-            }
-        }
+    // The cached help text no longer describes every argument.
+    _xo_args_clear_help_cache(context);
+
+    XO_ARGS_ARG_FLAG const declared_flags = _xo_args_declared_flags(flags);
+    xo_args_arg * const arg = (xo_args_arg *)_xo_args_tracked_alloc(
+        context, _xo_args_arg_struct_size(declared_flags));
+    _xo_args_init_arg(arg,
+                      _xo_args_copy_string(context, name),
+                      _xo_args_copy_string(context, short_name),
+                      _xo_args_copy_string(context, value_tip),
+                      _xo_args_copy_string(context, description),
+                      declared_flags);
+
+    _xo_args_reserve_args(context, 1);
+    arg->position = context->args_size;
+    context->args[context->args_size++] = arg;
+    _XO_ARGS_STATS_STOP(context, declare_ns);
+    return arg;
+}
 
-        return true;
+////////////////////////////////////////////////////////////////////////////////
+bool xo_args_declare_args(xo_args_ctx * const context,
+                          xo_args_arg_desc const * const descs,
+                          size_t const count,
+                          xo_args_arg ** const out_args)
+{
+    if (NULL == context)
+    {
+        XO_ARGS_ASSERT(NULL != context, "xo_args_ctx must not be null here.");
+        return false;
     }
-    else if (arg->flags & XO_ARGS_TYPE_DOUBLE_ARRAY)
+    if (NULL == descs && 0 != count)
     {
-        char const * argv_name = context->argv[*argv_index];
-        _xo_args_arg_array * const array = (_xo_args_arg_array *)arg;
-        size_t next_index = (*argv_index) + 1;
-        if (next_index >= (size_t)context->argc)
-        {
-            context->print("Error: No value provided for %s\n",
-                           context->argv[*argv_index]);
-            return false;
-        }
+        XO_ARGS_ASSERT(NULL != descs, "descs must not be null here.");
+        return false;
+    }
+    if (false == _xo_args_can_declare(context))
+    {
+        return false;
+    }
 
-        char const * next_value = context->argv[next_index];
-        double parsed_value;
+    _XO_ARGS_STATS_START();
 
-        if (true
-            == _xo_args_try_parse_double(context->argv[next_index],
-                                         &parsed_value))
-        {
-            _xo_args_arg_array_push(
-                context, array, &parsed_value, sizeof(double));
-            arg->has_value = true;
-            *argv_index = next_index;
-        }
-        else
+    // Check every descriptor before declaring anything so an invalid table
+    // leaves the context unchanged.
+    size_t block_size = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        xo_args_arg_desc const * const desc = &descs[i];
+        if (false
+            == _xo_args_check_declaration(
+                desc->name, desc->short_name, desc->flags))
         {
-            context->print("Error: Value for %s is not a valid number or is "
-                           "out of range\n",
-                           argv_name);
             return false;
         }
-
-        // Consume every following value until we see a valid argument
-        for (++next_index; next_index < (size_t)context->argc; ++next_index)
-        {
-            next_value = context->argv[next_index];
-
-            for (size_t j = 0; j < context->args_size; ++j)
-            {
-                xo_args_arg const * const other_arg = context->args[j];
-                if (_xo_args_arg_matches_input(other_arg, next_value, NULL))
-                {
-                    // The next argument is a valid arg so don't parse
-                    // that as a value of this string array
-                    return true;
-                }
-            }
-
-            if (true
-                == _xo_args_try_parse_double(context->argv[next_index],
-                                             &parsed_value))
-            {
-                _xo_args_arg_array_push(
-                    context, array, &parsed_value, sizeof(double));
-                arg->has_value = true;
-                *argv_index = next_index;
-            }
-            else
-            {
-                context->print(
-                    "Error: Value for %s is not a valid number or is "
-                    "out of range\n",
-                    argv_name);
-                return false;
-            }
-        }
-
+        block_size += _xo_args_align(
+            _xo_args_arg_struct_size(_xo_args_declared_flags(desc->flags)));
+    }
+    if (0 == count)
+    {
         return true;
     }
-    else if (arg->flags & XO_ARGS_TYPE_BOOL_ARRAY)
+
+    // Every argument is carved out of one allocation.
+    char * const block = (char *)_xo_args_tracked_alloc(context, block_size);
+    size_t const first = context->args_size;
+    _xo_args_reserve_args(context, count);
+    char * curr = block;
+    for (size_t i = 0; i < count; ++i)
     {
-        char const * argv_name = context->argv[*argv_index];
-        _xo_args_arg_array * const array = (_xo_args_arg_array *)arg;
-        size_t next_index = (*argv_index) + 1;
-        if (next_index >= (size_t)context->argc)
-        {
-            context->print("Error: No value provided for %s\n", argv_name);
-            return false;
-        }
-        char const * next_value = context->argv[next_index];
+        xo_args_arg_desc const * const desc = &descs[i];
+        XO_ARGS_ARG_FLAG const declared_flags =
+            _xo_args_declared_flags(desc->flags);
+        xo_args_arg * const arg = (xo_args_arg *)curr;
+        _xo_args_init_arg(arg,
+                          desc->name,
+                          desc->short_name,
+                          desc->value_tip,
+                          desc->description,
+                          declared_flags);
+        arg->position = context->args_size;
+        context->args[context->args_size++] = arg;
+        curr += _xo_args_align(_xo_args_arg_struct_size(declared_flags));
+    }
 
-        bool parsed_value;
-        if (_xo_args_try_parse_bool(next_value, &parsed_value))
+    // Indexing every name finds any conflict in the table (or with arguments
+    // declared earlier) in one pass. The index is then ready for parsing.
+    bool conflict_is_short = false;
+    size_t const conflict = _xo_args_index_build(context, &conflict_is_short);
+    if (XO_ARGS_NO_INDEX != conflict)
+    {
+        xo_args_arg const * const arg = context->args[conflict];
+        if (conflict_is_short)
         {
-            _xo_args_arg_array_push(
-                context, array, &parsed_value, sizeof(bool));
-            arg->has_value = true;
-            *argv_index = next_index;
+            context->print("xo-args error: %s argument short_name conflict."
+                           " short_name: %s\n",
+                           __func__,
+                           arg->short_name);
         }
         else
         {
-            context->print("Error: Invalid value provided for %s\n"
-                           "expected true or false.\n",
-                           argv_name);
-            return false;
+            context->print("xo-args error: %s argument name conflict. name:"
+                           " %s\n",
+                           __func__,
+                           arg->name);
         }
+        context->args_size = first;
+        context->indexed_args = XO_ARGS_NO_INDEX;
+        _xo_args_tracked_free(context, block);
+        _XO_ARGS_STATS_STOP(context, declare_ns);
+        return false;
+    }
+    context->indexed_args = context->args_size;
 
-        // Consume every following value until we see a valid argument
-        for (++next_index; next_index < (size_t)context->argc; ++next_index)
-        {
-            next_value = context->argv[next_index];
-
-            for (size_t j = 0; j < context->args_size; ++j)
-            {
-                xo_args_arg const * const other_arg = context->args[j];
-                if (_xo_args_arg_matches_input(other_arg, next_value, NULL))
-                {
-                    // The next argument is a valid arg so don't parse
-                    // that as a value of this string array
-                    return true;
-                }
-            }
+    // The cached help text no longer describes every argument.
+    _xo_args_clear_help_cache(context);
 
-            if (_xo_args_try_parse_bool(next_value, &parsed_value))
-            {
-                _xo_args_arg_array_push(
-                    context, array, &parsed_value, sizeof(bool));
-                arg->has_value = true;
-                *argv_index = next_index;
-            }
-            else
-            {
-                context->print("Error: Invalid value provided for %s\n"
-                               "expected true or false.\n",
-                               argv_name);
-                return false;
-            }
+    if (NULL != out_args)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out_args[i] = context->args[first + i];
         }
-
-        return true;
     }
+    _XO_ARGS_STATS_STOP(context, declare_ns);
     return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool xo_args_submit(xo_args_ctx * const context)
+bool xo_args_freeze_schema(xo_args_ctx * const context)
 {
     if (NULL == context)
     {
         XO_ARGS_ASSERT(NULL != context, "xo_args_ctx must not be null here.");
         return false;
     }
-
-    xo_args_arg const * const arg_help = xo_args_declare_arg(
-        context, "help", "h", NULL, "show this message", XO_ARGS_TYPE_SWITCH);
-
-    xo_args_arg const * arg_version = NULL;
-    if (NULL != context->app_version)
+    if (context->parse_started || NULL != context->schema)
     {
-        arg_version = xo_args_declare_arg(context,
-                                          "version",
-                                          "v",
-                                          NULL,
-                                          "shows the program version",
-                                          XO_ARGS_TYPE_SWITCH);
+        XO_ARGS_ASSERT(false == context->parse_started
+                           && NULL == context->schema,
+                       "only a context that has not parsed anything and was "
+                       "not created from a schema can be frozen.");
+        return false;
     }
-
-    for (size_t i = 1; i < (size_t)context->argc; ++i)
+    if (false == context->frozen)
     {
-        char const * const argv_arg = context->argv[i];
-        size_t const argv_arg_len = strlen(argv_arg);
-
-        // This is an unexpected case but we will try to ignore it.
-        if (argv_arg_len == 0)
-        {
-            continue;
-        }
-        // All valid variables begin with '-' or '--' so a single
-        // character argument at this position is unexpected
-        // and so is a string not starting with '-'
-        else if (argv_arg_len == 1 || argv_arg[0] != '-')
-        {
-            context->print("Error: unknown argument \"%s\"\n", argv_arg);
-            _xo_print_try_help(context);
-            return false;
-        }
-        // At this point there is a chance the user has input a valid argument
-        else
-        {
-            bool parsed_arg = false;
-            for (size_t j = 0; j < context->args_size; ++j)
-            {
-                _xo_args_arg_match match;
-                if (_xo_args_arg_matches_input(
-                        context->args[j], argv_arg, &match))
-                {
-                    if (false
-                        == _xo_args_try_parse_arg(
-                            context, &i, context->args[j], &match))
-                    {
-                        _xo_print_try_help(context);
-                        return false;
-                    }
-                    parsed_arg = true;
-                    break;
-                }
-            }
-            if (parsed_arg)
-            {
-                continue;
-            }
-            else
-            {
-                // the argv_arg looks like an argument but didn't match any
-                // known arguments.
-                context->print("Error: unknown argument \"%s\"\n", argv_arg);
-                _xo_print_try_help(context);
-                return false;
-            }
-        }
+        _xo_args_prepare(context);
+        context->frozen = true;
     }
+    return true;
+}
 
-    bool help = false;
-    if (xo_args_try_get_bool(arg_help, &help) && true == help)
+////////////////////////////////////////////////////////////////////////////////
+xo_args_ctx * xo_args_create_ctx_from_schema(xo_args_ctx const * const schema,
+                                             xo_argc_t const argc,
+                                             xo_argv_t const argv)
+{
+    if (NULL == schema || false == schema->frozen)
     {
-        xo_args_print_help(context);
-        return false;
+        XO_ARGS_ASSERT(NULL != schema && schema->frozen,
+                       "schema must be a frozen context.");
+        return NULL;
     }
 
-    bool version = false;
-    if ((NULL != context->app_version)
-        && xo_args_try_get_bool(arg_version, &version) && (true == version))
+    // The version and documentation are borrowed from the schema below. The
+    // app name is passed so it is not derived from argv[0] again.
+    xo_args_ctx_options options;
+    memset(&options, 0, sizeof(options));
+    options.app_name = schema->app_name;
+    options.alloc_fn = schema->alloc;
+    options.realloc_fn = schema->realloc;
+    options.free_fn = schema->free;
+    options.print_fn = schema->print;
+    options.flags = schema->flags;
+    options.arena_chunk_size = schema->arena_chunk_size;
+    options.value_threads = schema->value_threads;
+    xo_args_ctx * const context =
+        xo_args_create_ctx_with_options(argc, argv, &options);
+    if (NULL == context)
     {
-        xo_args_print_help(context);
-        return false;
+        return NULL;
     }
-
-    for (size_t i = 0; i < context->args_size; ++i)
+    context->schema = schema;
+    context->app_version = schema->app_version;
+    context->app_version_length = schema->app_version_length;
+    context->app_documentation = schema->app_documentation;
+    context->app_documentation_length = schema->app_documentation_length;
+    context->index = schema->index;
+    context->index_reserved = schema->index_reserved;
+    context->indexed_args = schema->indexed_args;
+    context->help_text = schema->help_text;
+    context->help_text_length = schema->help_text_length;
+
+    // Copy every argument into one allocation. The copies share the names
+    // and descriptions of the schema but get storage for values of their
+    // own.
+    size_t block_size = 0;
+    for (size_t i = 0; i < schema->args_size; ++i)
     {
-        xo_args_arg const * const arg = context->args[i];
-        if ((arg->flags & XO_ARGS_ARG_REQUIRED) && (false == arg->has_value))
-        {
-            if (NULL == arg->short_name)
-            {
-                context->print("Error: argument --%s is required.\n",
-                               arg->name);
-            }
-            else
-            {
-                context->print("Error: argument --%s / -%s is required.\n",
-                               arg->name,
-                               arg->short_name);
-            }
-            _xo_print_try_help(context);
-            return false;
-        }
+        block_size +=
+            _xo_args_align(_xo_args_arg_struct_size(schema->args[i]->flags));
     }
-
-    return true;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-void xo_args_destroy_ctx(xo_args_ctx * context)
-{
-    if (NULL == context)
+    _xo_args_reserve_args(context, schema->args_size);
+    char * curr = (char *)_xo_args_tracked_alloc(context, block_size);
+    for (size_t i = 0; i < schema->args_size; ++i)
     {
-        XO_ARGS_ASSERT(NULL != context, "xo_args_ctx must not be null here.");
-        return;
+        xo_args_arg const * const schema_arg = schema->args[i];
+        size_t const size = _xo_args_arg_struct_size(schema_arg->flags);
+        xo_args_arg * const arg = (xo_args_arg *)curr;
+        memcpy(arg, schema_arg, size);
+        _xo_args_clear_arg_storage(arg, arg->flags);
+        context->args[context->args_size++] = arg;
+        curr += _xo_args_align(size);
     }
-    // There is no need to use the tracked delete here.
-    // It performs extra work such as swapping elements which is intended to
-    // keep the list valid after freeing each element. We don't care about that.
-    for (size_t i = 0; i < context->allocations_size; ++i)
+    context->help_arg = context->args[schema->help_arg->position];
+    if (NULL != schema->version_arg)
     {
-        context->free(context->allocations[i]);
+        context->version_arg = context->args[schema->version_arg->position];
     }
-    context->free(context->allocations);
-    context->free(context);
+    return context;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-xo_args_arg * xo_args_declare_arg(xo_args_ctx * const context,
-                                  char const * const name,
-                                  char const * const short_name,
-                                  char const * const value_tip,
-                                  char const * const description,
-                                  XO_ARGS_ARG_FLAG const flags)
+xo_args_arg * xo_args_get_schema_arg(xo_args_ctx const * const context,
+                                     xo_args_arg const * const schema_arg)
 {
-    (void)value_tip;
-    (void)description;
-    if (NULL == context)
+    if (NULL == context || NULL == schema_arg)
     {
-        XO_ARGS_ASSERT(NULL != context, "xo_args_ctx must not be null here.");
+        XO_ARGS_ASSERT(NULL != context && NULL != schema_arg,
+                       "xo_args_ctx and schema_arg must not be null here.");
         return NULL;
     }
-    if (NULL == name)
+    xo_args_ctx const * const schema =
+        NULL != context->schema ? context->schema : context;
+    size_t const position = schema_arg->position;
+    if (position >= schema->args_size || schema->args[position] != schema_arg)
     {
-        XO_ARGS_ASSERT(NULL != name, "name must not be null here");
+        XO_ARGS_ASSERT(false,
+                       "schema_arg was not declared on the schema of "
+                       "context.");
         return NULL;
     }
+    return context->args[position];
+}
 
-    size_t const name_len = strlen(name);
-    XO_ARGS_ASSERT(name_len != 0,
-                   "name must be a valid string with a length >= 1");
+////////////////////////////////////////////////////////////////////////////////
+struct xo_args_batch
+{
+    xo_args_free_fn free;
+    size_t job_count;
+    size_t invalid_count;
+    // The errors of every invalid job, each followed by a null terminator.
+    char * errors;
+    // Per job: the offset of its errors in errors or XO_ARGS_NO_INDEX if the
+    // job is valid.
+    size_t * error_offsets;
+};
 
-    size_t const short_name_len = NULL != short_name ? strlen(short_name) : 0;
-    XO_ARGS_ASSERT(short_name == NULL || short_name_len != 0,
-                   "if a short name is provided it must have a length >= 1");
+////////////////////////////////////////////////////////////////////////////////
+// The state shared by the workers of one call to xo_args_validate_batch.
+// Workers take chunks of XO_ARGS_BATCH_CHUNK jobs in order until none are
+// left, so a worker stuck with slow jobs does not hold the others up.
+typedef struct _xo_args_batch_run
+{
+    xo_args_batch * batch;
+    xo_args_ctx const * schema;
+    xo_args_job const * jobs;
+    size_t chunk_count;
+    size_t next_chunk;
+    // The worker that took each chunk. Its error offsets are relative to that
+    // worker's errors until the results are merged.
+    size_t * chunk_workers;
+#if defined(_XO_ARGS_WIN32_THREADS)
+    CRITICAL_SECTION lock;
+#elif defined(_XO_ARGS_PTHREADS)
+    pthread_mutex_t lock;
+#endif
+} _xo_args_batch_run;
 
-    bool const name_is_alnum = _xo_isalnum_str(name, name + name_len);
-    if (false == name_is_alnum)
+////////////////////////////////////////////////////////////////////////////////
+// One worker of xo_args_validate_batch and the errors printed by its context.
+typedef struct _xo_args_batch_worker
+{
+    _xo_args_batch_run * run;
+    size_t worker_index;
+    size_t invalid_count;
+    char * errors;
+    size_t errors_size;
+    size_t errors_reserved;
+    size_t errors_base; // where errors begin once the results are merged
+    _xo_args_thread thread;
+} _xo_args_batch_worker;
+
+////////////////////////////////////////////////////////////////////////////////
+// The worker running on this thread. The print function of a context has no
+// parameter to find it with.
+_XO_ARGS_THREAD_LOCAL _xo_args_batch_worker * g_xo_args_batch_worker = NULL;
+
+////////////////////////////////////////////////////////////////////////////////
+// Makes room for needed bytes in the errors of worker.
+void _xo_args_batch_reserve(_xo_args_batch_worker * const worker,
+                            size_t const needed)
+{
+    if (needed <= worker->errors_reserved)
     {
-        XO_ARGS_ASSERT(true == name_is_alnum,
-                       "argument names must be alphanumeric");
-        return NULL;
+        return;
     }
-
-    if (short_name_len > 0)
+    xo_args_ctx const * const schema = worker->run->schema;
+    size_t reserved =
+        0 == worker->errors_reserved ? 256 : worker->errors_reserved;
+    while (reserved < needed)
     {
-        bool const short_name_is_alnum =
-            _xo_isalnum_str(short_name, short_name + short_name_len);
-        if (false == short_name_is_alnum)
-        {
-            XO_ARGS_ASSERT(true == short_name_is_alnum,
-                           "argument short names must be alphanumeric");
-            return NULL;
-        }
+        reserved *= 2;
     }
+    worker->errors =
+        (char *)(NULL == worker->errors
+                     ? schema->alloc(reserved)
+                     : schema->realloc(worker->errors, reserved));
+    worker->errors_reserved = reserved;
+}
 
-    XO_ARGS_ARG_FLAG const all_types =
-        (XO_ARGS_ARG_FLAG)(XO_ARGS_TYPE_STRING | XO_ARGS_TYPE_SWITCH
-                           | XO_ARGS_TYPE_BOOL | XO_ARGS_TYPE_INT
-                           | XO_ARGS_TYPE_DOUBLE | XO_ARGS_TYPE_BOOL_ARRAY
-                           | XO_ARGS_TYPE_INT_ARRAY | XO_ARGS_TYPE_DOUBLE_ARRAY
-                           | XO_ARGS_TYPE_STRING_ARRAY);
+////////////////////////////////////////////////////////////////////////////////
+// The print function of the contexts of batch workers: appends to the errors
+// of the worker on this thread.
+int _xo_args_batch_print(char const * const fmt, ...)
+{
+    _xo_args_batch_worker * const worker = g_xo_args_batch_worker;
+    va_list args;
+    va_start(args, fmt);
+    int const length = vsnprintf(NULL, 0, fmt, args);
+    va_end(args);
+    if (length <= 0)
     {
-        // Extract the type from the provided flags and count the set bits
-        // if there is more than one type bit set: the argument declaration is
-        // invalid.
-        XO_ARGS_ARG_FLAG const type_flag =
-            (XO_ARGS_ARG_FLAG)(flags & all_types);
-        size_t type_flag_temp = type_flag;
-        size_t bits = 0;
-        for (; type_flag_temp; ++bits)
-        {
-            type_flag_temp &= type_flag_temp - 1;
-        }
-
-        if (bits > 1)
-        {
-            XO_ARGS_ASSERT(bits <= 1,
-                           "arguments must only have one or zero types set");
-            return NULL;
-        }
+        return length;
     }
+    _xo_args_batch_reserve(worker, worker->errors_size + (size_t)length + 1);
+    va_start(args, fmt);
+    vsnprintf(
+        worker->errors + worker->errors_size, (size_t)length + 1, fmt, args);
+    va_end(args);
+    worker->errors_size += (size_t)length;
+    return length;
+}
 
-    // Look for conflicts with existing arguments first.
-    for (size_t i = 0; i < context->args_size; ++i)
+////////////////////////////////////////////////////////////////////////////////
+// Returns the next chunk of jobs for worker_index to parse or XO_ARGS_NO_INDEX
+// if there are none left.
+size_t _xo_args_batch_next_chunk(_xo_args_batch_run * const run,
+                                 size_t const worker_index)
+{
+#if defined(_XO_ARGS_WIN32_THREADS)
+    EnterCriticalSection(&run->lock);
+#elif defined(_XO_ARGS_PTHREADS)
+    pthread_mutex_lock(&run->lock);
+#endif
+    size_t const chunk = run->next_chunk < run->chunk_count
+                             ? run->next_chunk++
+                             : XO_ARGS_NO_INDEX;
+#if defined(_XO_ARGS_WIN32_THREADS)
+    LeaveCriticalSection(&run->lock);
+#elif defined(_XO_ARGS_PTHREADS)
+    pthread_mutex_unlock(&run->lock);
+#endif
+    if (XO_ARGS_NO_INDEX != chunk)
     {
-        xo_args_arg * const existing_arg = context->args[i];
-        if ((name_len == existing_arg->name_length)
-            && (0 == strcmp(existing_arg->name, name)))
-        {
-            context->print("xo-args error: %s argument name conflict. name:"
-                           " %s\n",
-                           __func__,
-                           name);
-            return NULL;
-        }
-        if ((NULL != short_name) && (NULL != existing_arg->short_name)
-            && (short_name_len == existing_arg->short_name_length)
-            && (0 == strcmp(existing_arg->short_name, short_name)))
-        {
-            context->print("xo-args error: %s argument short_name conflict."
-                           " short_name: %s\n",
-                           __func__,
-                           short_name);
-            return NULL;
-        }
+        run->chunk_workers[chunk] = worker_index;
     }
+    return chunk;
+}
 
-    // We're going to create a concrete argument and use it polymorphically
-    // throughout this function through an 'arg' variable.
-    _xo_args_arg_single * arg_single = NULL;
-    _xo_args_arg_array * arg_array = NULL;
-
-    if (_xo_args_arg_flag_is_array(flags))
+////////////////////////////////////////////////////////////////////////////////
+// True if job can be given to xo_args_reset_values.
+bool _xo_args_batch_job_is_valid(xo_args_job const * const job)
+{
+    if (job->argc < 1 || NULL == job->argv)
     {
-        arg_array = (_xo_args_arg_array *)_xo_args_tracked_alloc(
-            context, sizeof(_xo_args_arg_array));
-        // We will allocate the array on first push
-        arg_array->array_size = 0;
-        arg_array->array_reserved = 0;
-        arg_array->array = NULL;
+        return false;
     }
-    else
+    for (xo_argc_t i = 0; i < job->argc; ++i)
     {
-        arg_single = (_xo_args_arg_single *)_xo_args_tracked_alloc(
-            context, sizeof(_xo_args_arg_single));
+        if (NULL == job->argv[i])
+        {
+            return false;
+        }
     }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Parses chunks of jobs until none are left. Each job reuses one context
+// created from the schema.
+void _xo_args_batch_work(_xo_args_batch_worker * const worker)
+{
+    _xo_args_batch_run * const run = worker->run;
+    g_xo_args_batch_worker = worker;
 
-    xo_args_arg * const arg = NULL != arg_array ? (xo_args_arg *)arg_array
-                                                : (xo_args_arg *)arg_single;
-    if (context->args_reserved == context->args_size)
+    // Every job replaces this argv with xo_args_reset_values.
+    char const * const no_argv[1] = {""};
+    xo_args_ctx * const context =
+        xo_args_create_ctx_from_schema(run->schema, 1, no_argv);
+    context->print = _xo_args_batch_print;
+    // The workers already keep every processor busy.
+    context->value_threads = 1;
+
+    size_t chunk;
+    while (XO_ARGS_NO_INDEX
+           != (chunk = _xo_args_batch_next_chunk(run, worker->worker_index)))
     {
-        context->args_reserved *= 2;
-        context->args = (xo_args_arg **)_xo_args_tracked_realloc(
-            context,
-            context->args,
-            context->args_reserved * sizeof(xo_args_arg *));
+        size_t const first = chunk * XO_ARGS_BATCH_CHUNK;
+        size_t const end =
+            min(first + XO_ARGS_BATCH_CHUNK, run->batch->job_count);
+        for (size_t i = first; i < end; ++i)
+        {
+            xo_args_job const * const job = &run->jobs[i];
+            size_t const errors_start = worker->errors_size;
+            bool valid = false;
+            if (_xo_args_batch_job_is_valid(job))
+            {
+                xo_args_reset_values(context, job->argc, job->argv);
+                valid = xo_args_submit(context);
+            }
+            else
+            {
+                _xo_args_batch_print("xo-args error: the argv of job %lu is "
+                                     "invalid\n",
+                                     (unsigned long)i);
+            }
+
+            if (valid)
+            {
+                run->batch->error_offsets[i] = XO_ARGS_NO_INDEX;
+                // Anything printed by a valid job is not an error.
+                worker->errors_size = errors_start;
+                continue;
+            }
+            _xo_args_batch_reserve(worker, worker->errors_size + 1);
+            worker->errors[worker->errors_size++] = '\0';
+            run->batch->error_offsets[i] = errors_start;
+            ++worker->invalid_count;
+        }
     }
 
-    context->args[context->args_size++] = arg;
+    xo_args_destroy_ctx(context);
+    g_xo_args_batch_worker = NULL;
+}
 
-    // If any type flag is set: use the flags as is otherwise take the provided
-    // flags and assign the default type of string
-    arg->flags =
-        (XO_ARGS_ARG_FLAG)((all_types & flags) ? flags
-                                               : flags | XO_ARGS_TYPE_STRING);
+////////////////////////////////////////////////////////////////////////////////
+void _xo_args_batch_thread(void * const worker)
+{
+    _xo_args_batch_work((_xo_args_batch_worker *)worker);
+}
 
-    // A required switch doesn't make much sense so we will just assume the dev
-    // meant the switch should behave normally (optionally).
-    if ((XO_ARGS_TYPE_SWITCH | XO_ARGS_ARG_REQUIRED)
-        == (flags & (XO_ARGS_TYPE_SWITCH | XO_ARGS_ARG_REQUIRED)))
+////////////////////////////////////////////////////////////////////////////////
+xo_args_batch * xo_args_validate_batch(xo_args_ctx const * const schema,
+                                       xo_args_job const * const jobs,
+                                       size_t const job_count,
+                                       size_t const thread_count)
+{
+    if (NULL == schema || false == schema->frozen)
     {
-        arg->flags = (XO_ARGS_ARG_FLAG)(arg->flags & ~XO_ARGS_ARG_REQUIRED);
+        XO_ARGS_ASSERT(NULL != schema && schema->frozen,
+                       "schema must be a frozen context.");
+        return NULL;
     }
-
+    if (NULL == jobs && 0 != job_count)
     {
-        char * const buff =
-            (char *)_xo_args_tracked_alloc(context, name_len + 1);
-        memcpy(buff, name, name_len + 1);
-        arg->name = buff;
-        arg->name_length = name_len;
+        XO_ARGS_ASSERT(NULL != jobs, "jobs must not be null here.");
+        return NULL;
     }
 
-    if (NULL != short_name)
-    {
-        char * const buff =
-            (char *)_xo_args_tracked_alloc(context, short_name_len + 1);
-        memcpy(buff, short_name, short_name_len + 1);
-        arg->short_name = buff;
-        arg->short_name_length = short_name_len;
-    }
-    else
+    xo_args_batch * const batch =
+        (xo_args_batch *)schema->alloc(sizeof(xo_args_batch));
+    batch->free = schema->free;
+    batch->job_count = job_count;
+    batch->invalid_count = 0;
+    batch->errors = NULL;
+    batch->error_offsets =
+        (size_t *)schema->alloc(sizeof(size_t) * (job_count + 1));
+
+    _xo_args_batch_run run;
+    run.batch = batch;
+    run.schema = schema;
+    run.jobs = jobs;
+    run.chunk_count =
+        (job_count + XO_ARGS_BATCH_CHUNK - 1) / XO_ARGS_BATCH_CHUNK;
+    run.next_chunk = 0;
+    run.chunk_workers =
+        (size_t *)schema->alloc(sizeof(size_t) * (run.chunk_count + 1));
+#if defined(_XO_ARGS_WIN32_THREADS)
+    InitializeCriticalSection(&run.lock);
+#elif defined(_XO_ARGS_PTHREADS)
+    pthread_mutex_init(&run.lock, NULL);
+#endif
+
+    // There is no use for more workers than chunks.
+    size_t worker_count =
+        0 != thread_count ? thread_count : _xo_args_processor_count();
+    worker_count = min(worker_count, run.chunk_count);
+    worker_count = worker_count > 0 ? worker_count : 1;
+    _xo_args_batch_worker * const workers = (_xo_args_batch_worker *)
+        schema->alloc(sizeof(_xo_args_batch_worker) * worker_count);
+    for (size_t i = 0; i < worker_count; ++i)
     {
-        arg->short_name = NULL;
-        arg->short_name_length = 0;
+        _xo_args_batch_worker * const worker = &workers[i];
+        memset(worker, 0, sizeof(*worker));
+        worker->run = &run;
+        worker->worker_index = i;
     }
 
-    if (NULL != description)
+    // The calling thread is the first worker. If a thread can not be created
+    // the other workers take its share of the jobs.
+    for (size_t i = 1; i < worker_count; ++i)
     {
-        size_t const description_length = strlen(description);
-        char * const buff =
-            (char *)_xo_args_tracked_alloc(context, description_length + 1);
-        memcpy(buff, description, description_length + 1);
-        arg->description = buff;
-        arg->description_length = description_length;
+        _xo_args_thread_start(
+            &workers[i].thread, _xo_args_batch_thread, &workers[i]);
     }
-    else
+    _xo_args_batch_work(&workers[0]);
+    for (size_t i = 1; i < worker_count; ++i)
     {
-        arg->description = NULL;
-        arg->description_length = 0;
+        _xo_args_thread_join(&workers[i].thread);
     }
+#if defined(_XO_ARGS_WIN32_THREADS)
+    DeleteCriticalSection(&run.lock);
+#elif defined(_XO_ARGS_PTHREADS)
+    pthread_mutex_destroy(&run.lock);
+#endif
 
-    if (NULL != value_tip)
+    // Merge the errors of every worker into one allocation, in worker order.
+    size_t errors_size = 0;
+    for (size_t i = 0; i < worker_count; ++i)
     {
-        size_t const value_tip_length = strlen(value_tip);
-        char * const buff =
-            (char *)_xo_args_tracked_alloc(context, value_tip_length + 1);
-        memcpy(buff, value_tip, value_tip_length + 1);
-        arg->value_tip = buff;
-        arg->value_tip_length = value_tip_length;
+        _xo_args_batch_worker * const worker = &workers[i];
+        worker->errors_base = errors_size;
+        errors_size += worker->errors_size;
+        batch->invalid_count += worker->invalid_count;
     }
-    else if (arg->flags & XO_ARGS_TYPE_STRING)
+    if (0 != errors_size)
     {
-        arg->value_tip = "TEXT";
-        arg->value_tip_length = 4;
+        batch->errors = (char *)schema->alloc(errors_size);
     }
-    else if (arg->flags & XO_ARGS_TYPE_INT)
+    for (size_t i = 0; i < worker_count; ++i)
     {
-        arg->value_tip = "INTEGER";
-        arg->value_tip_length = 7;
+        _xo_args_batch_worker * const worker = &workers[i];
+        if (NULL != worker->errors)
+        {
+            memcpy(batch->errors + worker->errors_base,
+                   worker->errors,
+                   worker->errors_size);
+            schema->free(worker->errors);
+        }
     }
-    else if (arg->flags & XO_ARGS_TYPE_DOUBLE)
+    for (size_t chunk = 0; chunk < run.chunk_count; ++chunk)
     {
-        arg->value_tip = "NUMBER";
-        arg->value_tip_length = 6;
+        size_t const base = workers[run.chunk_workers[chunk]].errors_base;
+        size_t const first = chunk * XO_ARGS_BATCH_CHUNK;
+        size_t const end = min(first + XO_ARGS_BATCH_CHUNK, job_count);
+        for (size_t i = first; i < end; ++i)
+        {
+            if (XO_ARGS_NO_INDEX != batch->error_offsets[i])
+            {
+                batch->error_offsets[i] += base;
+            }
+        }
     }
-    else if (arg->flags & XO_ARGS_TYPE_BOOL)
+
+    schema->free(workers);
+    schema->free(run.chunk_workers);
+    return batch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+size_t xo_args_batch_invalid_count(xo_args_batch const * const batch)
+{
+    if (NULL == batch)
     {
-        arg->value_tip = "TRUE|FALSE";
-        arg->value_tip_length = 10;
+        XO_ARGS_ASSERT(NULL != batch, "batch must not be null here.");
+        return 0;
     }
-    else if (arg->flags & XO_ARGS_TYPE_STRING_ARRAY)
+    return batch->invalid_count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+char const * xo_args_batch_get_errors(xo_args_batch const * const batch,
+                                      size_t const job)
+{
+    if (NULL == batch || job >= batch->job_count)
     {
-        arg->value_tip = "[TEXT]...";
-        arg->value_tip_length = 9;
+        XO_ARGS_ASSERT(NULL != batch && job < batch->job_count,
+                       "job must be the index of a job in batch.");
+        return NULL;
     }
-    else if (arg->flags & XO_ARGS_TYPE_INT_ARRAY)
+    size_t const offset = batch->error_offsets[job];
+    return XO_ARGS_NO_INDEX != offset ? batch->errors + offset : NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_destroy_batch(xo_args_batch * const batch)
+{
+    if (NULL == batch)
     {
-        arg->value_tip = "[INTEGER]...";
-        arg->value_tip_length = 12;
+        XO_ARGS_ASSERT(NULL != batch, "batch must not be null here.");
+        return;
     }
-    else if (arg->flags & XO_ARGS_TYPE_DOUBLE_ARRAY)
+    if (NULL != batch->errors)
     {
-        arg->value_tip = "[NUMBER]...";
-        arg->value_tip_length = 11;
+        batch->free(batch->errors);
     }
-    else if (arg->flags & XO_ARGS_TYPE_BOOL_ARRAY)
+    batch->free(batch->error_offsets);
+    batch->free(batch);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_set_capacity_hint(xo_args_arg * const arg, size_t const capacity)
+{
+    if (NULL == arg || false == _xo_args_arg_flag_is_array(arg->flags))
     {
-        arg->value_tip = "[TRUE|FALSE]...";
-        arg->value_tip_length = 15;
+        XO_ARGS_ASSERT(NULL != arg && _xo_args_arg_flag_is_array(arg->flags),
+                       "Only array arguments take a capacity hint.");
+        return;
     }
-    else
+    ((_xo_args_arg_array *)arg)->capacity_hint = capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_set_value_callback(xo_args_arg * const arg,
+                                xo_args_value_fn const value_fn,
+                                void * const user_data)
+{
+    if (NULL == arg || false == _xo_args_arg_flag_is_array(arg->flags))
     {
-        // Switches don't get a tip because they don't have a value that follows
-        arg->value_tip = NULL;
-        arg->value_tip_length = 0;
+        XO_ARGS_ASSERT(NULL != arg && _xo_args_arg_flag_is_array(arg->flags),
+                       "Only array arguments take a value callback.");
+        return;
     }
-
-    arg->has_value = false;
-    return arg;
+    _xo_args_arg_array * const array = (_xo_args_arg_array *)arg;
+    array->value_fn = value_fn;
+    array->value_fn_user_data = user_data;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2145,6 +6275,50 @@ bool xo_args_try_get_string_array(xo_args_arg const * const arg,
     return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool xo_args_try_get_string_array_packed(xo_args_arg const * const arg,
+                                         char const ** out_chars,
+                                         size_t const ** out_offsets,
+                                         size_t const ** out_lengths,
+                                         size_t * out_array_count)
+{
+    if (NULL == arg)
+    {
+        XO_ARGS_ASSERT(NULL != arg, "argument is null");
+        return false;
+    }
+    if (NULL == out_chars || NULL == out_offsets || NULL == out_lengths)
+    {
+        XO_ARGS_ASSERT(
+            NULL != out_chars && NULL != out_offsets && NULL != out_lengths,
+            "out param is null");
+        return false;
+    }
+    if (NULL == out_array_count)
+    {
+        XO_ARGS_ASSERT(NULL != out_array_count, "out param is null");
+        return false;
+    }
+    if (XO_ARGS_TYPE_STRING_ARRAY != (arg->flags & XO_ARGS_TYPE_STRING_ARRAY))
+    {
+        XO_ARGS_ASSERT(arg->flags & XO_ARGS_TYPE_STRING_ARRAY,
+                       "incorrect argument type");
+        return false;
+    }
+    _xo_args_arg_string_array const * const array =
+        (_xo_args_arg_string_array const *)arg;
+    // With XO_ARGS_CTX_BORROW_ARGV values are never copied into the blob.
+    if (true == arg->has_value && NULL != array->blob)
+    {
+        *out_array_count = array->base.array_size;
+        *out_chars = array->blob;
+        *out_offsets = array->offsets;
+        *out_lengths = array->lengths;
+        return true;
+    }
+    return false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool xo_args_try_get_int_array(xo_args_arg const * const arg,
                                int64_t const ** out_int_array,
@@ -2249,6 +6423,106 @@ bool xo_args_try_get_bool_array(xo_args_arg const * const arg,
     }
     return false;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// Binds arg to binding (and binding_count for arrays) if arg has one of the
+// types in type_flags.
+void _xo_args_bind(xo_args_arg * const arg,
+                   XO_ARGS_ARG_FLAG const type_flags,
+                   void * const binding,
+                   size_t * const binding_count)
+{
+    if (NULL == arg)
+    {
+        XO_ARGS_ASSERT(NULL != arg, "argument is null");
+        return;
+    }
+    if (NULL == binding)
+    {
+        XO_ARGS_ASSERT(NULL != binding, "out param is null");
+        return;
+    }
+    if (0 == (arg->flags & type_flags))
+    {
+        XO_ARGS_ASSERT(arg->flags & type_flags, "incorrect argument type");
+        return;
+    }
+    if (_xo_args_arg_flag_is_array(arg->flags) && NULL == binding_count)
+    {
+        XO_ARGS_ASSERT(NULL != binding_count, "out param is null");
+        return;
+    }
+    arg->binding = binding;
+    arg->binding_count = binding_count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_bind_string(xo_args_arg * const arg,
+                         char const ** const out_string)
+{
+    _xo_args_bind(arg, XO_ARGS_TYPE_STRING, (void *)out_string, NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_bind_int(xo_args_arg * const arg, int64_t * const out_int)
+{
+    _xo_args_bind(arg, XO_ARGS_TYPE_INT, (void *)out_int, NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_bind_double(xo_args_arg * const arg, double * const out_double)
+{
+    _xo_args_bind(arg, XO_ARGS_TYPE_DOUBLE, (void *)out_double, NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_bind_bool(xo_args_arg * const arg, bool * const out_bool)
+{
+    _xo_args_bind(arg,
+                  (XO_ARGS_ARG_FLAG)(XO_ARGS_TYPE_BOOL | XO_ARGS_TYPE_SWITCH),
+                  (void *)out_bool,
+                  NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_bind_string_array(xo_args_arg * const arg,
+                               char const *** const out_string_array,
+                               size_t * const out_array_count)
+{
+    _xo_args_bind(arg,
+                  XO_ARGS_TYPE_STRING_ARRAY,
+                  (void *)out_string_array,
+                  out_array_count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_bind_int_array(xo_args_arg * const arg,
+                            int64_t const ** const out_int_array,
+                            size_t * const out_array_count)
+{
+    _xo_args_bind(
+        arg, XO_ARGS_TYPE_INT_ARRAY, (void *)out_int_array, out_array_count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_bind_double_array(xo_args_arg * const arg,
+                               double const ** const out_double_array,
+                               size_t * const out_array_count)
+{
+    _xo_args_bind(arg,
+                  XO_ARGS_TYPE_DOUBLE_ARRAY,
+                  (void *)out_double_array,
+                  out_array_count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void xo_args_bind_bool_array(xo_args_arg * const arg,
+                             bool const ** const out_bool_array,
+                             size_t * const out_array_count)
+{
+    _xo_args_bind(
+        arg, XO_ARGS_TYPE_BOOL_ARRAY, (void *)out_bool_array, out_array_count);
+}
 #endif
 // This is free and unencumbered software released into the public domain.
 //
@@ -0,0 +1,523 @@
+////////////////////////////////////////////////////////////////////////////////
+// xo-args.hpp - v1.0 - public domain
+// authored from 2024-2025 by Jared Thomson
+//
+// An optional C++17 layer over xo-args.h. The arguments of a program are
+// declared as constexpr options and handed to xo_args::parser as template
+// arguments, so the whole argument table is known at compile time.
+//
+// LICENSE
+//
+//  See the end of xo-args.h for license information.
+//
+// MAIN FEATURES
+//
+//      1. Invalid names and names or short names that conflict with each other
+//         (or with the built-in --help / -h) are compile errors.
+//      2. Each option's type is part of its declaration. parser::get returns
+//         the value with that type: there is no runtime type check and no
+//         flag to get wrong.
+//      3. Everything else is xo-args.h: parsing, help text, error messages
+//         and any arguments declared at runtime through parser::context.
+//
+// USAGE
+//
+//  xo-args.h must still be implemented in ONE C or C++ file by defining
+//  XO_ARGS_IMPL before including it (see xo-args.h).
+//
+//      constexpr xo_args::option<std::string_view> message{
+//          "message", "m", "MSG", "a message to print", true};
+//      constexpr xo_args::option<int64_t> repeat{
+//          "repeat", "r", "COUNT", "the number of times to print it"};
+//      constexpr xo_args::option<xo_args::switch_t> verbose{
+//          "verbose", "V", nullptr, "print additional info"};
+//
+//      xo_args::parser<message, repeat, verbose> args(argc, argv);
+//      if (!args.submit())
+//      {
+//          return 1;
+//      }
+//      std::string_view const text = *args.get<message>();
+//      int64_t const count = args.get<repeat>().value_or(10);
+//      bool const is_verbose = args.get<verbose>();
+//
+//  Option types and what parser::get returns for them:
+//      std::string_view            std::optional<std::string_view>
+//      int64_t                     std::optional<int64_t>
+//      double                      std::optional<double>
+//      bool                        std::optional<bool>
+//      xo_args::switch_t           bool
+//      xo_args::array<char const *>
+//                                  xo_args::array_view<char const *>
+//      xo_args::array<int64_t>     xo_args::array_view<int64_t>
+//      xo_args::array<double>      xo_args::array_view<double>
+//      xo_args::array<bool>        xo_args::array_view<bool>
+//
+//  Values are read from the context once, by parser::submit. Strings and
+//  arrays point into the context and are valid until the parser is destroyed
+//  or reset.
+////////////////////////////////////////////////////////////////////////////////
+#if !defined(__XO_ARGS_HPP__)
+#define __XO_ARGS_HPP__
+
+#if (defined(_MSVC_LANG) ? _MSVC_LANG : __cplusplus) < 201703L
+#error "xo-args.hpp requires C++17 or newer"
+#endif
+
+#include <xo-args/xo-args.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace xo_args
+{
+    ////////////////////////////////////////////////////////////////////////////
+    // The type of a switch option. Its value is false unless it was given.
+    struct switch_t
+    {
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // The type of an array option of T: char const *, int64_t, double or bool.
+    template <typename T>
+    struct array
+    {
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // The values of an array option. An option that was not given is empty.
+    template <typename T>
+    struct array_view
+    {
+        T const * values = nullptr;
+        std::size_t count = 0;
+
+        T const * begin() const
+        {
+            return values;
+        }
+        T const * end() const
+        {
+            return values + count;
+        }
+        std::size_t size() const
+        {
+            return count;
+        }
+        bool empty() const
+        {
+            return 0 == count;
+        }
+        T const & operator[](std::size_t const i) const
+        {
+            return values[i];
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // The declaration of one argument. See xo_args_declare_arg for the meaning
+    // of each member. Declare options constexpr so they can be passed to
+    // xo_args::parser.
+    template <typename T>
+    struct option
+    {
+        char const * name;
+        char const * short_name = nullptr;
+        char const * value_tip = nullptr;
+        char const * description = nullptr;
+        bool required = false;
+    };
+
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////////////////
+        // Maps an option type to its XO_ARGS_ARG_FLAG and the type returned by
+        // parser::get. Types without a specialization are not supported.
+        template <typename T>
+        struct traits;
+
+        template <>
+        struct traits<std::string_view>
+        {
+            static constexpr int flag = XO_ARGS_TYPE_STRING;
+            using value_type = std::optional<std::string_view>;
+            static value_type read(xo_args_arg const * const arg)
+            {
+                char const * value = nullptr;
+                if (xo_args_try_get_string(arg, &value))
+                {
+                    return std::string_view(value);
+                }
+                return std::nullopt;
+            }
+        };
+
+        template <>
+        struct traits<int64_t>
+        {
+            static constexpr int flag = XO_ARGS_TYPE_INT;
+            using value_type = std::optional<int64_t>;
+            static value_type read(xo_args_arg const * const arg)
+            {
+                int64_t value = 0;
+                if (xo_args_try_get_int(arg, &value))
+                {
+                    return value;
+                }
+                return std::nullopt;
+            }
+        };
+
+        template <>
+        struct traits<double>
+        {
+            static constexpr int flag = XO_ARGS_TYPE_DOUBLE;
+            using value_type = std::optional<double>;
+            static value_type read(xo_args_arg const * const arg)
+            {
+                double value = 0.0;
+                if (xo_args_try_get_double(arg, &value))
+                {
+                    return value;
+                }
+                return std::nullopt;
+            }
+        };
+
+        template <>
+        struct traits<bool>
+        {
+            static constexpr int flag = XO_ARGS_TYPE_BOOL;
+            using value_type = std::optional<bool>;
+            static value_type read(xo_args_arg const * const arg)
+            {
+                bool value = false;
+                if (xo_args_try_get_bool(arg, &value))
+                {
+                    return value;
+                }
+                return std::nullopt;
+            }
+        };
+
+        template <>
+        struct traits<switch_t>
+        {
+            static constexpr int flag = XO_ARGS_TYPE_SWITCH;
+            using value_type = bool;
+            static value_type read(xo_args_arg const * const arg)
+            {
+                bool value = false;
+                xo_args_try_get_bool(arg, &value);
+                return value;
+            }
+        };
+
+        template <>
+        struct traits<array<char const *>>
+        {
+            static constexpr int flag = XO_ARGS_TYPE_STRING_ARRAY;
+            using value_type = array_view<char const *>;
+            static value_type read(xo_args_arg const * const arg)
+            {
+                char const ** values = nullptr;
+                value_type view;
+                if (xo_args_try_get_string_array(arg, &values, &view.count))
+                {
+                    view.values = values;
+                }
+                return view;
+            }
+        };
+
+        template <>
+        struct traits<array<int64_t>>
+        {
+            static constexpr int flag = XO_ARGS_TYPE_INT_ARRAY;
+            using value_type = array_view<int64_t>;
+            static value_type read(xo_args_arg const * const arg)
+            {
+                value_type view;
+                xo_args_try_get_int_array(arg, &view.values, &view.count);
+                return view;
+            }
+        };
+
+        template <>
+        struct traits<array<double>>
+        {
+            static constexpr int flag = XO_ARGS_TYPE_DOUBLE_ARRAY;
+            using value_type = array_view<double>;
+            static value_type read(xo_args_arg const * const arg)
+            {
+                value_type view;
+                xo_args_try_get_double_array(arg, &view.values, &view.count);
+                return view;
+            }
+        };
+
+        template <>
+        struct traits<array<bool>>
+        {
+            static constexpr int flag = XO_ARGS_TYPE_BOOL_ARRAY;
+            using value_type = array_view<bool>;
+            static value_type read(xo_args_arg const * const arg)
+            {
+                value_type view;
+                xo_args_try_get_bool_array(arg, &view.values, &view.count);
+                return view;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////
+        // The T of an option<T> given the declared type of an option object.
+        template <typename Option>
+        struct option_type;
+
+        template <typename T>
+        struct option_type<option<T>>
+        {
+            using type = T;
+        };
+
+        template <typename Option>
+        using option_type_t = typename option_type<
+            std::remove_cv_t<std::remove_reference_t<Option>>>::type;
+
+        ////////////////////////////////////////////////////////////////////////
+        struct names
+        {
+            char const * name;
+            char const * short_name;
+        };
+
+        ////////////////////////////////////////////////////////////////////////
+        constexpr bool same_name(char const * a, char const * b)
+        {
+            if (nullptr == a || nullptr == b)
+            {
+                return false;
+            }
+            while ('\0' != *a && *a == *b)
+            {
+                ++a;
+                ++b;
+            }
+            return *a == *b;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // The same rule xo_args_declare_arg applies: letters, digits and '-'.
+        constexpr bool valid_name(char const * name)
+        {
+            if (nullptr == name || '\0' == *name)
+            {
+                return false;
+            }
+            for (; '\0' != *name; ++name)
+            {
+                char const c = *name;
+                if (!((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')
+                      || (c >= '0' && c <= '9') || '-' == c))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        template <std::size_t N>
+        constexpr bool names_are_valid(names const (&table)[N])
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                if (!valid_name(table[i].name)
+                    || (nullptr != table[i].short_name
+                        && !valid_name(table[i].short_name)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        template <std::size_t N>
+        constexpr bool names_are_unique(names const (&table)[N])
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                if (same_name(table[i].name, "help")
+                    || same_name(table[i].short_name, "h"))
+                {
+                    return false;
+                }
+                for (std::size_t j = 0; j < i; ++j)
+                {
+                    if (same_name(table[i].name, table[j].name)
+                        || same_name(table[i].short_name, table[j].short_name))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        template <typename A, typename B>
+        constexpr bool same_object(A const & a, B const & b)
+        {
+            if constexpr (std::is_same_v<A, B>)
+            {
+                return &a == &b;
+            }
+            else
+            {
+                (void)a;
+                (void)b;
+                return false;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // The position of Option in Options or sizeof...(Options) if it is not
+        // one of them.
+        template <auto const & Option, auto const &... Options>
+        constexpr std::size_t index_of()
+        {
+            bool const matches[] = {same_object(Option, Options)...};
+            std::size_t index = 0;
+            while (index < sizeof...(Options) && !matches[index])
+            {
+                ++index;
+            }
+            return index;
+        }
+    } // namespace detail
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Owns an xo-args context with Options declared. Options must be constexpr
+    // xo_args::option objects with static storage duration.
+    template <auto const &... Options>
+    class parser
+    {
+        static_assert(sizeof...(Options) > 0,
+                      "xo_args::parser needs at least one option");
+
+        static constexpr detail::names s_names[sizeof...(Options)] = {
+            {Options.name, Options.short_name}...};
+
+        static_assert(detail::names_are_valid(s_names),
+                      "option names and short names must not be empty and may "
+                      "only contain letters, digits and '-'");
+        static_assert(detail::names_are_unique(s_names),
+                      "option names and short names must not conflict with "
+                      "each other or with --help / -h");
+
+      public:
+        using values_type = std::tuple<typename detail::traits<
+            detail::option_type_t<decltype(Options)>>::value_type...>;
+
+        ////////////////////////////////////////////////////////////////////////
+        // Creates the context and declares every option. options may be null.
+        // See: xo_args_create_ctx_with_options
+        parser(int const argc,
+               char const * const * const argv,
+               xo_args_ctx_options const * const options = nullptr)
+            : m_context(xo_args_create_ctx_with_options(argc, argv, options)),
+              m_args(),
+              m_values()
+        {
+            // The option strings are static so the table can borrow them.
+            static xo_args_arg_desc const s_descs[] = {describe(Options)...};
+            xo_args_declare_args(
+                m_context, s_descs, sizeof...(Options), m_args);
+        }
+
+        ~parser()
+        {
+            xo_args_destroy_ctx(m_context);
+        }
+
+        parser(parser const &) = delete;
+        parser & operator=(parser const &) = delete;
+
+        ////////////////////////////////////////////////////////////////////////
+        // Parses argv and reads the value of every option.
+        // See: xo_args_submit
+        bool submit()
+        {
+            if (!xo_args_submit(m_context))
+            {
+                return false;
+            }
+            read_values(std::index_sequence_for<decltype(Options)...>());
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Prepares to parse a new argc and argv with submit. Values from the
+        // previous parse are invalid after this call.
+        // See: xo_args_reset_values
+        void reset(int const argc, char const * const * const argv)
+        {
+            xo_args_reset_values(m_context, argc, argv);
+            m_values = values_type();
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // The value of Option after a successful submit.
+        template <auto const & Option>
+        auto const & get() const
+        {
+            constexpr std::size_t index =
+                detail::index_of<Option, Options...>();
+            static_assert(index < sizeof...(Options),
+                          "the option was not given to this xo_args::parser");
+            return std::get<index>(m_values);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // The underlying context, for anything the C API does that this layer
+        // does not (declaring arguments at runtime, help text, etc.).
+        xo_args_ctx * context() const
+        {
+            return m_context;
+        }
+
+      private:
+        template <typename T>
+        static xo_args_arg_desc describe(option<T> const & declared)
+        {
+            int const flags =
+                detail::traits<T>::flag
+                | (declared.required ? XO_ARGS_ARG_REQUIRED : 0);
+            return {declared.name,
+                    declared.short_name,
+                    declared.value_tip,
+                    declared.description,
+                    (XO_ARGS_ARG_FLAG)flags};
+        }
+
+        template <std::size_t... I>
+        void read_values(std::index_sequence<I...>)
+        {
+            ((std::get<I>(m_values) = detail::traits<detail::option_type_t<
+                  decltype(Options)>>::read(m_args[I])),
+             ...);
+        }
+
+        xo_args_ctx * m_context;
+        xo_args_arg * m_args[sizeof...(Options)];
+        values_type m_values;
+    };
+} // namespace xo_args
+
+#endif // __XO_ARGS_HPP__
@@ -0,0 +1,786 @@
+////////////////////////////////////////////////////////////////////////////////
+// xo-args-bench measures the cost of parsing a few representative command
+// lines. Every scenario builds the same input on every run so results can be
+// compared between builds and releases.
+//
+// For each scenario the whole life of a context is timed: creating it,
+// declaring arguments, submitting and destroying it. The best and mean times
+// of a number of runs are reported per parse. Timed runs use the default
+// allocator. One extra run uses the counting allocator from the tests
+// to report the allocations made and the peak bytes held by a single parse.
+//
+// Usage:
+//      xo-args-bench [--iterations N] [--scenario NAME...] [--json]
+//      xo-args-bench --batch JOBS [--threads MAX] [--iterations N] [--json]
+//
+// --json prints one JSON object per scenario instead of a table, which is
+// meant for tracking results over time.
+//
+// --batch validates JOBS copies of the small scenario against a frozen schema
+// with xo_args_validate_batch on 1, 2, 4... up to MAX threads, showing how
+// the batch scales with threads.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "../tests/utest.h"
+#include "../tests/xo-args-test-funcs.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define XO_ARGS_IMPL
+#include <xo-args/xo-args.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// The shortest time measured at once. See _bench_run.
+#define BENCH_MIN_RUN_NS 1000000
+
+////////////////////////////////////////////////////////////////////////////////
+// The argv and argument declarations of one scenario. Strings are formatted
+// into storage which is sized up front so pointers into it remain valid.
+typedef struct bench_input
+{
+    char const ** argv;
+    int argc;
+    int argv_reserved;
+
+    xo_args_arg_desc * descs;
+    size_t desc_count;
+    size_t desc_reserved;
+
+    char * storage;
+    size_t storage_size;
+    size_t storage_reserved;
+
+    // The result xo_args_submit should have for this input.
+    bool expect_success;
+} bench_input;
+
+////////////////////////////////////////////////////////////////////////////////
+typedef struct bench_scenario
+{
+    char const * name;
+    void (*make_input)(bench_input * const input);
+} bench_scenario;
+
+////////////////////////////////////////////////////////////////////////////////
+typedef struct bench_result
+{
+    int tokens;
+    int iterations;
+    utest_int64_t best_ns;
+    utest_int64_t mean_ns;
+    size_t allocations;
+    size_t peak_bytes;
+} bench_result;
+
+////////////////////////////////////////////////////////////////////////////////
+// Scenarios print help text and nothing else. Rendering the help text is part
+// of what is measured but writing it to stdout is not.
+static int _bench_print(char const * const fmt, ...)
+{
+    (void)fmt;
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void _bench_input_init(bench_input * const input,
+                              int const argv_reserved,
+                              size_t const desc_reserved,
+                              size_t const storage_reserved)
+{
+    memset(input, 0, sizeof(*input));
+    input->argv = (char const **)malloc(sizeof(char *) * (size_t)argv_reserved);
+    input->argv_reserved = argv_reserved;
+    input->descs = (xo_args_arg_desc *)malloc(sizeof(xo_args_arg_desc)
+                                              * (desc_reserved + 1));
+    input->desc_reserved = desc_reserved;
+    input->storage = (char *)malloc(storage_reserved);
+    input->storage_reserved = storage_reserved;
+    input->expect_success = true;
+
+    input->argv[input->argc++] = "/mock/xo-args-bench";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void _bench_input_free(bench_input * const input)
+{
+    free((void *)input->argv);
+    free(input->descs);
+    free(input->storage);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Formats a string into the input's storage and returns it.
+static char const * _bench_format(bench_input * const input,
+                                  char const * const fmt,
+                                  ...)
+{
+    char * const str = &input->storage[input->storage_size];
+    size_t const available = input->storage_reserved - input->storage_size;
+    va_list ap;
+    va_start(ap, fmt);
+    int const printed = vsnprintf(str, available, fmt, ap);
+    va_end(ap);
+    if (printed < 0 || (size_t)printed >= available)
+    {
+        fprintf(stderr, "xo-args-bench: scenario storage is too small\n");
+        exit(1);
+    }
+    input->storage_size += (size_t)printed + 1;
+    return str;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void _bench_push_token(bench_input * const input,
+                              char const * const token)
+{
+    if (input->argc == input->argv_reserved)
+    {
+        fprintf(stderr, "xo-args-bench: scenario argv is too small\n");
+        exit(1);
+    }
+    input->argv[input->argc++] = token;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void _bench_push_desc(bench_input * const input,
+                             char const * const name,
+                             char const * const short_name,
+                             char const * const value_tip,
+                             char const * const description,
+                             XO_ARGS_ARG_FLAG const flags)
+{
+    if (input->desc_count == input->desc_reserved)
+    {
+        fprintf(stderr, "xo-args-bench: scenario declarations are too small\n");
+        exit(1);
+    }
+    xo_args_arg_desc * const desc = &input->descs[input->desc_count++];
+    desc->name = name;
+    desc->short_name = short_name;
+    desc->value_tip = value_tip;
+    desc->description = description;
+    desc->flags = flags;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// A typical small tool: a handful of arguments and tokens.
+static void _bench_make_small(bench_input * const input)
+{
+    _bench_input_init(input, 16, 8, 0);
+    _bench_push_desc(input, "verbose", "V", NULL, NULL, XO_ARGS_TYPE_SWITCH);
+    _bench_push_desc(input, "output", "o", NULL, NULL, XO_ARGS_TYPE_STRING);
+    _bench_push_desc(input, "count", "c", NULL, NULL, XO_ARGS_TYPE_INT);
+    _bench_push_desc(input, "ratio", "r", NULL, NULL, XO_ARGS_TYPE_DOUBLE);
+    _bench_push_desc(
+        input, "input", "i", NULL, NULL, XO_ARGS_TYPE_STRING_ARRAY);
+
+    _bench_push_token(input, "-V");
+    _bench_push_token(input, "-o");
+    _bench_push_token(input, "out.txt");
+    _bench_push_token(input, "--count");
+    _bench_push_token(input, "3");
+    _bench_push_token(input, "-r=0.5");
+    _bench_push_token(input, "-i");
+    _bench_push_token(input, "a.txt");
+    _bench_push_token(input, "b.txt");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 500 declared int arrays "arg-N"/"aN" and 10,000 tokens that set them by name
+// and short name in a scattered order.
+static void _bench_make_many_args(bench_input * const input)
+{
+    enum
+    {
+        ARG_COUNT = 500,
+        PAIR_COUNT = 5000
+    };
+    _bench_input_init(
+        input, PAIR_COUNT * 2 + 1, ARG_COUNT, (ARG_COUNT + PAIR_COUNT) * 32);
+    for (int i = 0; i < ARG_COUNT; ++i)
+    {
+        _bench_push_desc(input,
+                         _bench_format(input, "arg-%d", i),
+                         _bench_format(input, "a%d", i),
+                         NULL,
+                         NULL,
+                         XO_ARGS_TYPE_INT_ARRAY);
+    }
+    for (int i = 0; i < PAIR_COUNT; ++i)
+    {
+        int const arg = (i * 7919) % ARG_COUNT;
+        _bench_push_token(input,
+                          (i & 1) ? _bench_format(input, "-a%d", arg)
+                                  : _bench_format(input, "--arg-%d", arg));
+        _bench_push_token(input, _bench_format(input, "%d", i));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// One string, int and double array with 10,000 values each.
+static void _bench_make_long_arrays(bench_input * const input)
+{
+    enum
+    {
+        VALUE_COUNT = 10000
+    };
+    _bench_input_init(input, VALUE_COUNT * 3 + 4, 3, VALUE_COUNT * 3 * 24);
+    _bench_push_desc(
+        input, "strings", "s", NULL, NULL, XO_ARGS_TYPE_STRING_ARRAY);
+    _bench_push_desc(input, "ints", "i", NULL, NULL, XO_ARGS_TYPE_INT_ARRAY);
+    _bench_push_desc(
+        input, "doubles", "d", NULL, NULL, XO_ARGS_TYPE_DOUBLE_ARRAY);
+
+    _bench_push_token(input, "--strings");
+    for (int i = 0; i < VALUE_COUNT; ++i)
+    {
+        _bench_push_token(input, _bench_format(input, "value-%d", i));
+    }
+    _bench_push_token(input, "--ints");
+    for (int i = 0; i < VALUE_COUNT; ++i)
+    {
+        _bench_push_token(input, _bench_format(input, "%d", i * 37 - 5000));
+    }
+    _bench_push_token(input, "--doubles");
+    for (int i = 0; i < VALUE_COUNT; ++i)
+    {
+        _bench_push_token(input, _bench_format(input, "%d.%03d", i, i % 1000));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 10,000 tokens of the form --name=value: every string "text-N" once followed
+// by assignments to int, double and string arrays.
+static void _bench_make_assignments(bench_input * const input)
+{
+    enum
+    {
+        GROUP_SIZE = 64,
+        TOKEN_COUNT = 10000
+    };
+    _bench_input_init(input,
+                      TOKEN_COUNT + 1,
+                      GROUP_SIZE * 4,
+                      (GROUP_SIZE * 4 + TOKEN_COUNT) * 32);
+    for (int i = 0; i < GROUP_SIZE; ++i)
+    {
+        _bench_push_desc(input,
+                         _bench_format(input, "text-%d", i),
+                         NULL,
+                         NULL,
+                         NULL,
+                         XO_ARGS_TYPE_STRING);
+        _bench_push_desc(input,
+                         _bench_format(input, "int-%d", i),
+                         NULL,
+                         NULL,
+                         NULL,
+                         XO_ARGS_TYPE_INT_ARRAY);
+        _bench_push_desc(input,
+                         _bench_format(input, "double-%d", i),
+                         NULL,
+                         NULL,
+                         NULL,
+                         XO_ARGS_TYPE_DOUBLE_ARRAY);
+        _bench_push_desc(input,
+                         _bench_format(input, "list-%d", i),
+                         NULL,
+                         NULL,
+                         NULL,
+                         XO_ARGS_TYPE_STRING_ARRAY);
+    }
+    for (int i = 0; i < GROUP_SIZE; ++i)
+    {
+        _bench_push_token(input, _bench_format(input, "--text-%d=t%d", i, i));
+    }
+    for (int i = GROUP_SIZE; i < TOKEN_COUNT; ++i)
+    {
+        int const arg = i % GROUP_SIZE;
+        char const * token = NULL;
+        switch (i % 3)
+        {
+        case 0:
+            token = _bench_format(input, "--int-%d=%d", arg, i);
+            break;
+        case 1:
+            token = _bench_format(input, "--double-%d=%d.25", arg, i);
+            break;
+        default:
+            token = _bench_format(input, "--list-%d=item%d", arg, i);
+            break;
+        }
+        _bench_push_token(input, token);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// --help with 100 documented arguments of every type.
+static void _bench_make_help(bench_input * const input)
+{
+    enum
+    {
+        ARG_COUNT = 100
+    };
+    static XO_ARGS_ARG_FLAG const types[] = {XO_ARGS_TYPE_SWITCH,
+                                             XO_ARGS_TYPE_STRING,
+                                             XO_ARGS_TYPE_INT,
+                                             XO_ARGS_TYPE_DOUBLE,
+                                             XO_ARGS_TYPE_BOOL,
+                                             XO_ARGS_TYPE_STRING_ARRAY,
+                                             XO_ARGS_TYPE_INT_ARRAY,
+                                             XO_ARGS_TYPE_DOUBLE_ARRAY,
+                                             XO_ARGS_TYPE_BOOL_ARRAY};
+    size_t const type_count = sizeof(types) / sizeof(types[0]);
+    _bench_input_init(input, 2, ARG_COUNT, ARG_COUNT * 96);
+    for (int i = 0; i < ARG_COUNT; ++i)
+    {
+        XO_ARGS_ARG_FLAG const type = types[(size_t)i % type_count];
+        _bench_push_desc(
+            input,
+            _bench_format(input, "option-%d", i),
+            _bench_format(input, "o%d", i),
+            (i % 4) ? NULL : "VALUE",
+            _bench_format(input, "the description of option number %d", i),
+            (i % 10) ? type
+                     : (XO_ARGS_ARG_FLAG)(type | XO_ARGS_ARG_REQUIRED));
+    }
+    _bench_push_token(input, "--help");
+    input->expect_success = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bench_scenario const g_scenarios[] = {
+    {"small", _bench_make_small},
+    {"many_args", _bench_make_many_args},
+    {"long_arrays", _bench_make_long_arrays},
+    {"assignments", _bench_make_assignments},
+    {"help", _bench_make_help},
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Creates a context, declares every argument, submits and destroys it. Returns
+// false if the submit result is not what the scenario expects.
+static bool _bench_parse(bench_input const * const input,
+                         xo_args_ctx_options const * const options)
+{
+    xo_args_ctx * const context = xo_args_create_ctx_with_options(
+        input->argc, (xo_argv_t)input->argv, options);
+    for (size_t i = 0; i < input->desc_count; ++i)
+    {
+        xo_args_arg_desc const * const desc = &input->descs[i];
+        xo_args_declare_arg(context,
+                            desc->name,
+                            desc->short_name,
+                            desc->value_tip,
+                            desc->description,
+                            desc->flags);
+    }
+    bool const result = xo_args_submit(context);
+    xo_args_destroy_ctx(context);
+    return result == input->expect_success;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the nanoseconds taken by batch parses or -1 if one failed.
+static utest_int64_t
+_bench_time_batch(bench_input const * const input,
+                  xo_args_ctx_options const * const options,
+                  int const batch)
+{
+    utest_int64_t const start = utest_ns();
+    for (int i = 0; i < batch; ++i)
+    {
+        if (false == _bench_parse(input, options))
+        {
+            return -1;
+        }
+    }
+    return utest_ns() - start;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool _bench_run(bench_input const * const input,
+                       int const iterations,
+                       bench_result * const out_result)
+{
+    xo_args_ctx_options options;
+    memset(&options, 0, sizeof(options));
+    options.app_name = "xo-args-bench";
+    options.app_version = "1.0";
+    options.app_documentation = "Documentation for the help scenario.";
+    options.print_fn = _bench_print;
+
+    memset(out_result, 0, sizeof(*out_result));
+    out_result->tokens = input->argc - 1;
+    out_result->iterations = iterations;
+
+    // Count the allocations of one parse first. This also warms up the
+    // caches and the default allocator for the timed runs.
+    test_global_clear();
+    options.alloc_fn = test_alloc;
+    options.realloc_fn = test_realloc;
+    options.free_fn = test_free;
+    if (false == _bench_parse(input, &options))
+    {
+        return false;
+    }
+    out_result->allocations = test_get_allocation_calls();
+    out_result->peak_bytes = test_get_peak_allocated_bytes();
+
+    options.alloc_fn = NULL;
+    options.realloc_fn = NULL;
+    options.free_fn = NULL;
+
+    // The timer may only be accurate to a microsecond or so. Each timed run
+    // repeats the parse enough times to take at least BENCH_MIN_RUN_NS.
+    int batch = 1;
+    for (;;)
+    {
+        utest_int64_t const elapsed = _bench_time_batch(input, &options, batch);
+        if (elapsed < 0)
+        {
+            return false;
+        }
+        if (elapsed >= BENCH_MIN_RUN_NS)
+        {
+            break;
+        }
+        batch *= 2;
+    }
+
+    utest_int64_t total = 0;
+    for (int i = 0; i < iterations; ++i)
+    {
+        utest_int64_t const elapsed = _bench_time_batch(input, &options, batch);
+        if (elapsed < 0)
+        {
+            return false;
+        }
+        if (0 == i || elapsed < out_result->best_ns)
+        {
+            out_result->best_ns = elapsed;
+        }
+        total += elapsed;
+    }
+    out_result->best_ns /= batch;
+    out_result->mean_ns = total / iterations / batch;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void _bench_print_result(char const * const name,
+                                bench_result const * const result,
+                                bool const json)
+{
+    double const ns_per_token =
+        (double)result->best_ns / (double)result->tokens;
+    if (json)
+    {
+        printf("{\"scenario\": \"%s\", \"tokens\": %d, \"iterations\": %d, "
+               "\"best_ns\": %lld, \"mean_ns\": %lld, \"ns_per_token\": %.2f, "
+               "\"allocations\": %lu, \"peak_bytes\": %lu}\n",
+               name,
+               result->tokens,
+               result->iterations,
+               (long long)result->best_ns,
+               (long long)result->mean_ns,
+               ns_per_token,
+               (unsigned long)result->allocations,
+               (unsigned long)result->peak_bytes);
+    }
+    else
+    {
+        printf("%-12s %8d %12lld %12lld %10.2f %8lu %12lu\n",
+               name,
+               result->tokens,
+               (long long)result->best_ns,
+               (long long)result->mean_ns,
+               ns_per_token,
+               (unsigned long)result->allocations,
+               (unsigned long)result->peak_bytes);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Validates job_count copies of the small scenario with xo_args_validate_batch
+// using 1, 2, 4... up to max_threads threads. Every tenth job passes an
+// unknown argument so errors are collected too. Prints the best time of each
+// thread count and its speedup over one thread.
+static bool _bench_batch(size_t const job_count,
+                         size_t const max_threads,
+                         int const iterations,
+                         bool const json)
+{
+    bench_input input;
+    _bench_make_small(&input);
+
+    xo_args_ctx_options options;
+    memset(&options, 0, sizeof(options));
+    options.app_name = "xo-args-bench";
+    options.print_fn = _bench_print;
+    xo_args_ctx * const schema =
+        xo_args_create_ctx_with_options(1, (xo_argv_t)input.argv, &options);
+    for (size_t i = 0; i < input.desc_count; ++i)
+    {
+        xo_args_arg_desc const * const desc = &input.descs[i];
+        xo_args_declare_arg(schema,
+                            desc->name,
+                            desc->short_name,
+                            desc->value_tip,
+                            desc->description,
+                            desc->flags);
+    }
+    xo_args_freeze_schema(schema);
+
+    static char const * const invalid_argv[] = {"/mock/xo-args-bench",
+                                                "--unknown"};
+    size_t const expect_invalid = (job_count + 9) / 10;
+    xo_args_job * const jobs =
+        (xo_args_job *)malloc(sizeof(xo_args_job) * job_count);
+    for (size_t i = 0; i < job_count; ++i)
+    {
+        if (0 == i % 10)
+        {
+            jobs[i].argc = 2;
+            jobs[i].argv = (xo_argv_t)invalid_argv;
+        }
+        else
+        {
+            jobs[i].argc = input.argc;
+            jobs[i].argv = (xo_argv_t)input.argv;
+        }
+    }
+
+    if (false == json)
+    {
+        printf("%-8s %8s %14s %14s %8s\n",
+               "threads",
+               "jobs",
+               "best ns",
+               "jobs/s",
+               "speedup");
+    }
+
+    bool result = true;
+    utest_int64_t single_ns = 0;
+    for (size_t threads = 1; result && threads <= max_threads; threads *= 2)
+    {
+        utest_int64_t best_ns = 0;
+        for (int i = 0; i < iterations; ++i)
+        {
+            utest_int64_t const start = utest_ns();
+            xo_args_batch * const batch =
+                xo_args_validate_batch(schema, jobs, job_count, threads);
+            utest_int64_t const elapsed = utest_ns() - start;
+            if (NULL == batch
+                || xo_args_batch_invalid_count(batch) != expect_invalid)
+            {
+                result = false;
+            }
+            xo_args_destroy_batch(batch);
+            if (0 == i || elapsed < best_ns)
+            {
+                best_ns = elapsed;
+            }
+        }
+        if (1 == threads)
+        {
+            single_ns = best_ns;
+        }
+
+        double const jobs_per_second =
+            (double)job_count * 1e9 / (double)(best_ns > 0 ? best_ns : 1);
+        double const speedup =
+            (double)single_ns / (double)(best_ns > 0 ? best_ns : 1);
+        if (json)
+        {
+            printf("{\"scenario\": \"batch\", \"threads\": %lu, "
+                   "\"jobs\": %lu, \"best_ns\": %lld, "
+                   "\"jobs_per_second\": %.0f, \"speedup\": %.2f}\n",
+                   (unsigned long)threads,
+                   (unsigned long)job_count,
+                   (long long)best_ns,
+                   jobs_per_second,
+                   speedup);
+        }
+        else
+        {
+            printf("%-8lu %8lu %14lld %14.0f %8.2f\n",
+                   (unsigned long)threads,
+                   (unsigned long)job_count,
+                   (long long)best_ns,
+                   jobs_per_second,
+                   speedup);
+        }
+    }
+
+    free(jobs);
+    xo_args_destroy_ctx(schema);
+    _bench_input_free(&input);
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool _bench_is_selected(char const * const name,
+                               char const ** const selected,
+                               size_t const selected_count)
+{
+    if (0 == selected_count)
+    {
+        return true;
+    }
+    for (size_t i = 0; i < selected_count; ++i)
+    {
+        if (0 == strcmp(selected[i], name))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main(xo_argc_t const argc, xo_argv_t const argv)
+{
+    xo_args_ctx * const context = xo_args_create_ctx_advanced(
+        argc,
+        argv,
+        "xo-args-bench",
+        "1.0",
+        "Measures the time and memory xo-args needs to parse a few "
+        "representative command lines.",
+        NULL,
+        NULL,
+        NULL,
+        NULL);
+
+    xo_args_arg const * const arg_iterations =
+        xo_args_declare_arg(context,
+                            "iterations",
+                            "n",
+                            "COUNT",
+                            "timed runs of each scenario. Default: 20",
+                            XO_ARGS_TYPE_INT);
+
+    xo_args_arg const * const arg_scenario = xo_args_declare_arg(
+        context,
+        "scenario",
+        "s",
+        "[NAME]...",
+        "run only these scenarios: small, many_args, long_arrays, "
+        "assignments, help",
+        XO_ARGS_TYPE_STRING_ARRAY);
+
+    xo_args_arg const * const arg_json =
+        xo_args_declare_arg(context,
+                            "json",
+                            "j",
+                            NULL,
+                            "print one JSON object per scenario",
+                            XO_ARGS_TYPE_SWITCH);
+
+    xo_args_arg const * const arg_batch = xo_args_declare_arg(
+        context,
+        "batch",
+        "b",
+        "JOBS",
+        "validate JOBS small command lines with xo_args_validate_batch "
+        "instead of running the scenarios",
+        XO_ARGS_TYPE_INT);
+
+    xo_args_arg const * const arg_threads =
+        xo_args_declare_arg(context,
+                            "threads",
+                            "t",
+                            "MAX",
+                            "the most threads used by --batch. Default: 8",
+                            XO_ARGS_TYPE_INT);
+
+    if (false == xo_args_submit(context))
+    {
+        xo_args_destroy_ctx(context);
+        return 1;
+    }
+
+    int64_t iterations = 20;
+    xo_args_try_get_int(arg_iterations, &iterations);
+    if (iterations < 1)
+    {
+        iterations = 1;
+    }
+
+    char const ** selected = NULL;
+    size_t selected_count = 0;
+    xo_args_try_get_string_array(arg_scenario, &selected, &selected_count);
+
+    bool json = false;
+    xo_args_try_get_bool(arg_json, &json);
+
+    int64_t batch_jobs = 0;
+    int64_t max_threads = 8;
+    xo_args_try_get_int(arg_threads, &max_threads);
+    if (xo_args_try_get_int(arg_batch, &batch_jobs) && batch_jobs > 0)
+    {
+        bool const batch_result =
+            _bench_batch((size_t)batch_jobs,
+                         max_threads < 1 ? 1 : (size_t)max_threads,
+                         (int)iterations,
+                         json);
+        if (false == batch_result)
+        {
+            fprintf(stderr,
+                    "xo-args-bench: the batch did not validate as expected\n");
+        }
+        xo_args_destroy_ctx(context);
+        return batch_result ? 0 : 1;
+    }
+
+    if (false == json)
+    {
+        printf("%-12s %8s %12s %12s %10s %8s %12s\n",
+               "scenario",
+               "tokens",
+               "best ns",
+               "mean ns",
+               "ns/token",
+               "allocs",
+               "peak bytes");
+    }
+
+    test_global_setup();
+    int result = 0;
+    size_t const scenario_count = sizeof(g_scenarios) / sizeof(g_scenarios[0]);
+    for (size_t i = 0; i < scenario_count; ++i)
+    {
+        bench_scenario const * const scenario = &g_scenarios[i];
+        if (false
+            == _bench_is_selected(scenario->name, selected, selected_count))
+        {
+            continue;
+        }
+
+        bench_input input;
+        scenario->make_input(&input);
+        bench_result bench;
+        if (_bench_run(&input, (int)iterations, &bench))
+        {
+            _bench_print_result(scenario->name, &bench, json);
+        }
+        else
+        {
+            fprintf(stderr,
+                    "xo-args-bench: the %s scenario did not parse as "
+                    "expected\n",
+                    scenario->name);
+            result = 1;
+        }
+        _bench_input_free(&input);
+    }
+    test_global_shutdown();
+
+    xo_args_destroy_ctx(context);
+    return result;
+}
@@ -34,6 +34,10 @@ function setupCommonProject(name, lang, filePaths)
             "FatalCompileWarnings" 
         }
 
+        -- xo_args_validate_batch uses pthreads.
+        filter "system:linux"
+            links { "pthread" }
+
         filter "action:vs*"
             defines { "_CRT_SECURE_NO_WARNINGS" }
             clangtidy( "On" )
@@ -49,9 +53,15 @@ end
 
 -- Specific projects
 setupCommonProject("xo-args-tests", "C", { "../tests/**.h", "../tests/**.c", "../../include/xo-args/xo-args.h" })
+    filter {}
+    defines { "XO_ARGS_STATS" }
+setupCommonProject("xo-args-bench", "C", { "../bench/**.h", "../bench/**.c", "../tests/xo-args-test-funcs.h", "../tests/xo-args-test-funcs.c", "../../include/xo-args/xo-args.h" })
 setupCommonProject("01-hello-world", "C", { "../../examples/01-hello-world/**.h", "../../examples/01-hello-world/**.c", "../../include/xo-args/xo-args.h" })
 setupCommonProject("02-cpp", "C++", { "../../examples/02-cpp/**.h", "../../examples/02-cpp/**.cpp", "../../include/xo-args/xo-args.h" })
 setupCommonProject("03-sqlite3", "C", { "../../examples/03-sqlite3/**.h", "../../examples/03-sqlite3/**.c", "../../include/xo-args/xo-args.h" })
+setupCommonProject("04-cpp17", "C++", { "../../examples/04-cpp17/**.h", "../../examples/04-cpp17/**.cpp", "../../include/xo-args/xo-args.h", "../../include/xo-args/xo-args.hpp" })
+    filter {}
+    cppdialect("C++17")
 
 project "config-files"
     location("../build/" .. _ACTION)
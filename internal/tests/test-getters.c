@@ -102,6 +102,34 @@ void _test_init_context(struct getters * const utest_fixture,
             utest_fixture, (int)(sizeof(argv) / sizeof(argv[0])), argv);       \
     } while (0)
 
+////////////////////////////////////////////////////////////////////////////////
+void _test_init_context_with_flags(struct getters * const utest_fixture,
+                                   int const argc,
+                                   char const ** argv,
+                                   XO_ARGS_CTX_FLAG const flags)
+{
+    xo_args_ctx_options options;
+    memset(&options, 0, sizeof(options));
+    options.alloc_fn = test_alloc;
+    options.realloc_fn = test_realloc;
+    options.free_fn = test_free;
+    options.print_fn = test_printf;
+    options.flags = flags;
+    utest_fixture->context =
+        xo_args_create_ctx_with_options(argc, (xo_argv_t)argv, &options);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#define _TEST_INIT_CONTEXT_WITH_FLAGS(utest_fixture, argv, flags)              \
+    do                                                                         \
+    {                                                                          \
+        ASSERT_EQ(NULL, (void *)utest_fixture->context);                       \
+        _test_init_context_with_flags(utest_fixture,                           \
+                                      (int)(sizeof(argv) / sizeof(argv[0])),   \
+                                      argv,                                    \
+                                      flags);                                  \
+    } while (0)
+
 ////////////////////////////////////////////////////////////////////////////////
 // A helper to check that a test has concluded while only producing a certain
 // string as standard output. This depends on proper test setup and that the
@@ -2132,3 +2160,2180 @@ UTEST_F(getters, bool_array_array_many_values)
 
     _test_destroy_context(utest_fixture);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, many_args)
+{
+    // Enough arguments that the name index has to grow well past its initial
+    // size. Every argument is an int named "arg-N" with the short name "aN".
+    enum
+    {
+        ARG_COUNT = 300
+    };
+    char names[ARG_COUNT][16];
+    char short_names[ARG_COUNT][16];
+    xo_args_arg const * args[ARG_COUNT];
+
+    char const * argv[] = {"/mock/test.ext",
+                           "--arg-0",
+                           "0",
+                           "-a150",
+                           "150",
+                           "--arg-299=299",
+                           "-a42=42"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    for (int i = 0; i < ARG_COUNT; ++i)
+    {
+        snprintf(names[i], sizeof(names[i]), "arg-%i", i);
+        snprintf(short_names[i], sizeof(short_names[i]), "a%i", i);
+        args[i] = xo_args_declare_arg(utest_fixture->context,
+                                      names[i],
+                                      short_names[i],
+                                      NULL,
+                                      NULL,
+                                      XO_ARGS_TYPE_INT);
+        ASSERT_NE(NULL, (void *)args[i]);
+    }
+
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    for (int i = 0; i < ARG_COUNT; ++i)
+    {
+        int64_t value = -1;
+        bool const expect_value = (0 == i || 42 == i || 150 == i || 299 == i);
+        ASSERT_EQ(expect_value, xo_args_try_get_int(args[i], &value));
+        if (expect_value)
+        {
+            ASSERT_EQ(i, value);
+        }
+    }
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, unknown_arg_with_similar_names)
+{
+    char const * unknown_values[] = {"--fo", "--fooo", "-f", "--f", "-foo"};
+    size_t const unknown_values_count =
+        sizeof(unknown_values) / sizeof(unknown_values[0]);
+
+    for (size_t i = 0; i < unknown_values_count; ++i)
+    {
+        char const * argv[] = {"/mock/test.ext", unknown_values[i]};
+        _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+        xo_args_declare_arg(utest_fixture->context,
+                            "foo",
+                            "F",
+                            NULL,
+                            NULL,
+                            XO_ARGS_TYPE_SWITCH);
+        ASSERT_FALSE(xo_args_submit(utest_fixture->context));
+
+        _test_destroy_context(utest_fixture);
+
+        _TEST_EXPECT_STDOUT("unknown argument");
+        test_global_clear();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, short_name_matches_in_declaration_order)
+{
+    // A short name may begin with '-' which makes "--foo" ambiguous between
+    // the short name "-foo" and the name "foo". The first declared argument
+    // wins.
+    char const * argv[] = {"/mock/test.ext", "--foo"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg const * first = xo_args_declare_arg(utest_fixture->context,
+                                                    "first",
+                                                    "-foo",
+                                                    NULL,
+                                                    NULL,
+                                                    XO_ARGS_TYPE_SWITCH);
+    xo_args_arg const * second = xo_args_declare_arg(utest_fixture->context,
+                                                     "foo",
+                                                     NULL,
+                                                     NULL,
+                                                     NULL,
+                                                     XO_ARGS_TYPE_SWITCH);
+    ASSERT_NE(NULL, (void *)first);
+    ASSERT_NE(NULL, (void *)second);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    bool first_value = false;
+    bool second_value = true;
+    ASSERT_TRUE(xo_args_try_get_bool(first, &first_value));
+    ASSERT_TRUE(xo_args_try_get_bool(second, &second_value));
+    ASSERT_TRUE(first_value);
+    ASSERT_FALSE(second_value);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, arena_values)
+{
+    char const * argv[] = {"/mock/test.ext",
+                           "--str",
+                           "STR",
+                           "--int=-7",
+                           "--dbl",
+                           "2.5",
+                           "--flag",
+                           "--strs",
+                           "a",
+                           "b",
+                           "c",
+                           "d",
+                           "e",
+                           "f",
+                           "g",
+                           "h",
+                           "i",
+                           "--ints",
+                           "1",
+                           "2",
+                           "3"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(utest_fixture, argv, XO_ARGS_CTX_ARENA);
+
+    xo_args_arg const * str = xo_args_declare_arg(utest_fixture->context,
+                                                  "str",
+                                                  NULL,
+                                                  NULL,
+                                                  "a string",
+                                                  XO_ARGS_TYPE_STRING);
+    xo_args_arg const * integer = xo_args_declare_arg(
+        utest_fixture->context, "int", NULL, NULL, NULL, XO_ARGS_TYPE_INT);
+    xo_args_arg const * dbl = xo_args_declare_arg(
+        utest_fixture->context, "dbl", NULL, NULL, NULL, XO_ARGS_TYPE_DOUBLE);
+    xo_args_arg const * flag = xo_args_declare_arg(
+        utest_fixture->context, "flag", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+    xo_args_arg const * strs =
+        xo_args_declare_arg(utest_fixture->context,
+                            "strs",
+                            NULL,
+                            NULL,
+                            NULL,
+                            XO_ARGS_TYPE_STRING_ARRAY);
+    xo_args_arg const * ints = xo_args_declare_arg(utest_fixture->context,
+                                                   "ints",
+                                                   NULL,
+                                                   NULL,
+                                                   NULL,
+                                                   XO_ARGS_TYPE_INT_ARRAY);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    char const * str_value = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(str, &str_value));
+    ASSERT_STREQ("STR", str_value);
+
+    int64_t int_value = 0;
+    ASSERT_TRUE(xo_args_try_get_int(integer, &int_value));
+    ASSERT_EQ(-7, int_value);
+
+    double dbl_value = 0.0;
+    ASSERT_TRUE(xo_args_try_get_double(dbl, &dbl_value));
+    ASSERT_EQ(2.5, dbl_value);
+
+    bool flag_value = false;
+    ASSERT_TRUE(xo_args_try_get_bool(flag, &flag_value));
+    ASSERT_TRUE(flag_value);
+
+    char const ** strs_value = NULL;
+    size_t strs_count = 0;
+    ASSERT_TRUE(xo_args_try_get_string_array(strs, &strs_value, &strs_count));
+    ASSERT_EQ(9u, strs_count);
+    ASSERT_STREQ("a", strs_value[0]);
+    ASSERT_STREQ("e", strs_value[4]);
+    ASSERT_STREQ("i", strs_value[8]);
+
+    int64_t const * ints_value = NULL;
+    size_t ints_count = 0;
+    ASSERT_TRUE(xo_args_try_get_int_array(ints, &ints_value, &ints_count));
+    ASSERT_EQ(3u, ints_count);
+    ASSERT_EQ(1, ints_value[0]);
+    ASSERT_EQ(2, ints_value[1]);
+    ASSERT_EQ(3, ints_value[2]);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, arena_few_allocations)
+{
+    char const * argv[] = {"/mock/test.ext", "--arg-3", "three"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(utest_fixture, argv, XO_ARGS_CTX_ARENA);
+
+    char names[32][16];
+    for (int i = 0; i < 32; ++i)
+    {
+        snprintf(names[i], sizeof(names[i]), "arg-%i", i);
+        ASSERT_NE(NULL,
+                  (void *)xo_args_declare_arg(utest_fixture->context,
+                                              names[i],
+                                              NULL,
+                                              "VALUE",
+                                              "an argument with a description",
+                                              XO_ARGS_TYPE_STRING));
+    }
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    // The context itself plus a few chunks. Without the arena this is well
+    // over a hundred allocations.
+    size_t allocation_count;
+    test_get_allocations(&allocation_count);
+    ASSERT_LE(allocation_count, 8u);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, arena_invalid_input)
+{
+    char const * argv[] = {"/mock/test.ext", "--foo", "not-a-number"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(utest_fixture, argv, XO_ARGS_CTX_ARENA);
+
+    xo_args_declare_arg(
+        utest_fixture->context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_INT);
+    ASSERT_FALSE(xo_args_submit(utest_fixture->context));
+
+    _test_destroy_context(utest_fixture);
+
+    _TEST_EXPECT_STDOUT("is not a valid integer");
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, borrow_argv_string)
+{
+    char const * argv[] = {"/mock/test.ext", "--foo", "FOO", "--bar=BAR"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(
+        utest_fixture, argv, XO_ARGS_CTX_BORROW_ARGV);
+
+    xo_args_arg const * foo = xo_args_declare_arg(
+        utest_fixture->context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_STRING);
+    xo_args_arg const * bar = xo_args_declare_arg(
+        utest_fixture->context, "bar", NULL, NULL, NULL, XO_ARGS_TYPE_STRING);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    char const * foo_value = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(foo, &foo_value));
+    ASSERT_EQ((void const *)argv[2], (void const *)foo_value);
+
+    char const * bar_value = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(bar, &bar_value));
+    ASSERT_EQ((void const *)&argv[3][6], (void const *)bar_value);
+    ASSERT_STREQ("BAR", bar_value);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, borrow_argv_string_array)
+{
+    char const * argv[] = {
+        "/mock/test.ext", "--foo", "a", "b", "--bar", "--foo", "c"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(
+        utest_fixture, argv, XO_ARGS_CTX_BORROW_ARGV);
+
+    xo_args_arg const * foo =
+        xo_args_declare_arg(utest_fixture->context,
+                            "foo",
+                            NULL,
+                            NULL,
+                            NULL,
+                            XO_ARGS_TYPE_STRING_ARRAY);
+    xo_args_declare_arg(
+        utest_fixture->context, "bar", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+
+    size_t allocations_before_submit;
+    test_get_allocations(&allocations_before_submit);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    char const ** foo_value = NULL;
+    size_t foo_count = 0;
+    ASSERT_TRUE(xo_args_try_get_string_array(foo, &foo_value, &foo_count));
+    ASSERT_EQ(3u, foo_count);
+    ASSERT_EQ((void const *)argv[2], (void const *)foo_value[0]);
+    ASSERT_EQ((void const *)argv[3], (void const *)foo_value[1]);
+    ASSERT_EQ((void const *)argv[6], (void const *)foo_value[2]);
+
+    // Submitting may allocate the help argument, the name index and the array
+    // itself but no string copies.
+    size_t allocations_after_submit;
+    test_get_allocations(&allocations_after_submit);
+    ASSERT_LE(allocations_after_submit, allocations_before_submit + 8u);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, string_array_packed)
+{
+    char const * argv[] = {
+        "/mock/test.ext", "--foo", "a", "bb", "--bar", "--foo", "", "dddd"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg const * foo =
+        xo_args_declare_arg(utest_fixture->context,
+                            "foo",
+                            NULL,
+                            NULL,
+                            NULL,
+                            XO_ARGS_TYPE_STRING_ARRAY);
+    xo_args_declare_arg(
+        utest_fixture->context, "bar", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    char const * chars = NULL;
+    size_t const * offsets = NULL;
+    size_t const * lengths = NULL;
+    size_t count = 0;
+    ASSERT_TRUE(xo_args_try_get_string_array_packed(
+        foo, &chars, &offsets, &lengths, &count));
+    ASSERT_EQ(4u, count);
+
+    // Each value is followed by a null terminator in the blob.
+    size_t const expected_offsets[] = {0, 2, 5, 6};
+    size_t const expected_lengths[] = {1, 2, 0, 4};
+    for (size_t i = 0; i < count; ++i)
+    {
+        ASSERT_EQ(expected_offsets[i], offsets[i]);
+        ASSERT_EQ(expected_lengths[i], lengths[i]);
+    }
+    ASSERT_EQ(0, memcmp("a\0bb\0\0dddd", chars, 11));
+
+    // The regular getter points into the same memory.
+    char const ** strings = NULL;
+    size_t strings_count = 0;
+    ASSERT_TRUE(xo_args_try_get_string_array(foo, &strings, &strings_count));
+    ASSERT_EQ(count, strings_count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        ASSERT_EQ((void const *)(chars + offsets[i]), (void const *)strings[i]);
+    }
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, string_array_packed_growth)
+{
+    // Enough values that the blob is reallocated several times.
+    enum
+    {
+        VALUE_COUNT = 200
+    };
+    char values[VALUE_COUNT][16];
+    char const * argv[VALUE_COUNT + 2];
+    argv[0] = "/mock/test.ext";
+    argv[1] = "--foo";
+    for (int i = 0; i < VALUE_COUNT; ++i)
+    {
+        snprintf(values[i], sizeof(values[i]), "value-%i", i);
+        argv[i + 2] = values[i];
+    }
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg const * foo =
+        xo_args_declare_arg(utest_fixture->context,
+                            "foo",
+                            NULL,
+                            NULL,
+                            NULL,
+                            XO_ARGS_TYPE_STRING_ARRAY);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    char const ** strings = NULL;
+    size_t count = 0;
+    ASSERT_TRUE(xo_args_try_get_string_array(foo, &strings, &count));
+    ASSERT_EQ((size_t)VALUE_COUNT, count);
+
+    char const * chars = NULL;
+    size_t const * offsets = NULL;
+    size_t const * lengths = NULL;
+    ASSERT_TRUE(xo_args_try_get_string_array_packed(
+        foo, &chars, &offsets, &lengths, &count));
+    for (int i = 0; i < VALUE_COUNT; ++i)
+    {
+        ASSERT_STREQ(values[i], strings[i]);
+        ASSERT_EQ((void const *)(chars + offsets[i]), (void const *)strings[i]);
+        ASSERT_EQ(strlen(values[i]), lengths[i]);
+    }
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, string_array_packed_borrowed)
+{
+    char const * argv[] = {"/mock/test.ext", "--foo", "a", "b"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(
+        utest_fixture, argv, XO_ARGS_CTX_BORROW_ARGV);
+
+    xo_args_arg const * foo =
+        xo_args_declare_arg(utest_fixture->context,
+                            "foo",
+                            NULL,
+                            NULL,
+                            NULL,
+                            XO_ARGS_TYPE_STRING_ARRAY);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    char const * chars = NULL;
+    size_t const * offsets = NULL;
+    size_t const * lengths = NULL;
+    size_t count = 0;
+    ASSERT_FALSE(xo_args_try_get_string_array_packed(
+        foo, &chars, &offsets, &lengths, &count));
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, string_assignment_containing_assignment)
+{
+    char const * argv[] = {"/mock/test.ext", "--foo=a=b", "-b==c"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg const * foo = xo_args_declare_arg(
+        utest_fixture->context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_STRING);
+    xo_args_arg const * bar = xo_args_declare_arg(
+        utest_fixture->context, "bar", "b", NULL, NULL, XO_ARGS_TYPE_STRING);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    char const * foo_value = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(foo, &foo_value));
+    ASSERT_STREQ("a=b", foo_value);
+
+    char const * bar_value = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(bar, &bar_value));
+    ASSERT_STREQ("=c", bar_value);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, help_text)
+{
+    char const * argv[] = {"/mock/test.ext", "--help"};
+    xo_args_ctx_options options;
+    memset(&options, 0, sizeof(options));
+    options.app_version = "1.2.3";
+    options.app_documentation = "Documentation with 100% literal text.";
+    options.alloc_fn = test_alloc;
+    options.realloc_fn = test_realloc;
+    options.free_fn = test_free;
+    options.print_fn = test_printf;
+    utest_fixture->context =
+        xo_args_create_ctx_with_options(2, (xo_argv_t)argv, &options);
+
+    // Longer than the 128 byte line buffer help text used to be limited to.
+    char long_name[161];
+    memset(long_name, 'n', sizeof(long_name) - 1);
+    long_name[sizeof(long_name) - 1] = '\0';
+
+    xo_args_declare_arg(utest_fixture->context,
+                        "foo",
+                        "f",
+                        "<file>",
+                        "a required %s file",
+                        XO_ARGS_ARG_REQUIRED | XO_ARGS_TYPE_STRING);
+    xo_args_declare_arg(utest_fixture->context,
+                        long_name,
+                        NULL,
+                        NULL,
+                        "long",
+                        XO_ARGS_TYPE_SWITCH);
+    ASSERT_FALSE(xo_args_submit(utest_fixture->context));
+
+    char expected[1024];
+    snprintf(expected,
+             sizeof(expected),
+             "test version 1.2.3\n"
+             "Usage: test --foo [OPTIONS]...\n"
+             "Documentation with 100%% literal text.\n"
+             "REQUIRED ARGUMENTS:\n"
+             "  --foo, -f <file>%*sa required %%s file\n"
+             "OPTIONAL ARGUMENTS:\n"
+             "  --%s    long\n"
+             "  --help, -h%*sshow this message\n"
+             "  --version, -v%*sshows the program version\n",
+             (int)(166 - 16),
+             "",
+             long_name,
+             (int)(166 - 10),
+             "",
+             (int)(166 - 13),
+             "");
+    ASSERT_STREQ(expected, test_get_stdout());
+
+    // The same text is available without printing it.
+    size_t const length =
+        xo_args_render_help(utest_fixture->context, NULL, 0);
+    ASSERT_EQ(strlen(expected), length);
+
+    char * const rendered = (char *)malloc(length + 1);
+    ASSERT_EQ(
+        length,
+        xo_args_render_help(utest_fixture->context, rendered, length + 1));
+    ASSERT_STREQ(expected, rendered);
+
+    // A short buffer is truncated and null terminated like snprintf.
+    char truncated[8];
+    ASSERT_EQ(length,
+              xo_args_render_help(
+                  utest_fixture->context, truncated, sizeof(truncated)));
+    ASSERT_STREQ("test ve", truncated);
+    free(rendered);
+
+    _test_destroy_context(utest_fixture);
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, help_text_cached)
+{
+    char const * argv[] = {"/mock/test.ext"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(utest_fixture, argv, XO_ARGS_CTX_CACHE_HELP);
+
+    xo_args_declare_arg(utest_fixture->context,
+                        "foo",
+                        "f",
+                        NULL,
+                        "the foo",
+                        XO_ARGS_TYPE_SWITCH);
+    ASSERT_EQ(NULL, xo_args_get_help(utest_fixture->context, NULL));
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    size_t cached_length = 0;
+    char const * const cached =
+        xo_args_get_help(utest_fixture->context, &cached_length);
+    ASSERT_NE(NULL, cached);
+    ASSERT_EQ(strlen(cached), cached_length);
+    ASSERT_NE(NULL, strstr(cached, "  --foo, -f    the foo\n"));
+
+    // Printing and rendering return the cached text without allocating.
+    size_t allocations_before = 0;
+    test_get_allocations(&allocations_before);
+    xo_args_print_help(utest_fixture->context);
+    ASSERT_STREQ(cached, test_get_stdout());
+
+    char rendered[512];
+    ASSERT_EQ(cached_length,
+              xo_args_render_help(
+                  utest_fixture->context, rendered, sizeof(rendered)));
+    ASSERT_STREQ(cached, rendered);
+
+    size_t allocations_after = 0;
+    test_get_allocations(&allocations_after);
+    ASSERT_EQ(allocations_before, allocations_after);
+
+    // Declaring another argument invalidates the cache. Rendering still works.
+    xo_args_declare_arg(utest_fixture->context,
+                        "bar",
+                        NULL,
+                        NULL,
+                        "the bar",
+                        XO_ARGS_TYPE_SWITCH);
+    ASSERT_EQ(NULL, xo_args_get_help(utest_fixture->context, &cached_length));
+    ASSERT_EQ(0u, cached_length);
+    xo_args_render_help(utest_fixture->context, rendered, sizeof(rendered));
+    ASSERT_NE(NULL, strstr(rendered, "  --bar"));
+
+    _test_destroy_context(utest_fixture);
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, int_array_delimited)
+{
+    // Long enough for the vectorized scanner to see whole blocks.
+    char const * argv[] = {"/mock/test.ext",
+                           "--foo=1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17",
+                           "-f",
+                           "18 19\t20, 0x15 ,22",
+                           "23",
+                           "--foo",
+                           "-1,-2"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg const * foo = xo_args_declare_arg(
+        utest_fixture->context, "foo", "f", NULL, NULL, XO_ARGS_TYPE_INT_ARRAY);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    int64_t const * values = NULL;
+    size_t count = 0;
+    ASSERT_TRUE(xo_args_try_get_int_array(foo, &values, &count));
+    ASSERT_EQ(25u, count);
+    for (size_t i = 0; i < 23; ++i)
+    {
+        ASSERT_EQ((int64_t)i + 1, values[i]);
+    }
+    ASSERT_EQ(-1, values[23]);
+    ASSERT_EQ(-2, values[24]);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, double_array_delimited)
+{
+    char const * argv[] = {
+        "/mock/test.ext", "--foo", "0.5,1e3, -2.25", "--foo=inf 4"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg const * foo = xo_args_declare_arg(utest_fixture->context,
+                                                  "foo",
+                                                  NULL,
+                                                  NULL,
+                                                  NULL,
+                                                  XO_ARGS_TYPE_DOUBLE_ARRAY);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    double const * values = NULL;
+    size_t count = 0;
+    ASSERT_TRUE(xo_args_try_get_double_array(foo, &values, &count));
+    ASSERT_EQ(5u, count);
+    ASSERT_EQ(0.5, values[0]);
+    ASSERT_EQ(1000.0, values[1]);
+    ASSERT_EQ(-2.25, values[2]);
+    ASSERT_TRUE(values[3] > 1e308);
+    ASSERT_EQ(4.0, values[4]);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, int_array_delimited_invalid)
+{
+    char const * invalid_values[] = {
+        "1,,2", "1,2,", ",1", "1,x", " ", "1;2", "1,99999999999999999999"};
+    size_t const invalid_count =
+        sizeof(invalid_values) / sizeof(invalid_values[0]);
+
+    for (size_t i = 0; i < invalid_count; ++i)
+    {
+        char const * argv[] = {"/mock/test.ext", "--foo", invalid_values[i]};
+        _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+        xo_args_declare_arg(utest_fixture->context,
+                            "foo",
+                            NULL,
+                            NULL,
+                            NULL,
+                            XO_ARGS_TYPE_INT_ARRAY);
+        ASSERT_FALSE(xo_args_submit(utest_fixture->context));
+
+        _test_destroy_context(utest_fixture);
+        _TEST_EXPECT_STDOUT("Value for --foo is not a valid integer");
+        test_global_clear();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Writes contents to a file at path, replacing the file if it exists.
+static bool _test_write_file(char const * const path,
+                             char const * const contents)
+{
+    FILE * const file = fopen(path, "wb");
+    if (NULL == file)
+    {
+        return false;
+    }
+    size_t const length = strlen(contents);
+    bool const written = length == fwrite(contents, 1, length, file);
+    return 0 == fclose(file) && written;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the index of the allocation made with test_alloc/test_realloc that
+// ptr points into or (size_t)-1 if there is none.
+static size_t _test_find_allocation(void const * const ptr)
+{
+    size_t allocation_count;
+    allocation const * const allocations =
+        test_get_allocations(&allocation_count);
+    for (size_t i = 0; i < allocation_count; ++i)
+    {
+        char const * const memory = (char const *)allocations[i].memory;
+        if ((char const *)ptr >= memory
+            && (char const *)ptr < memory + allocations[i].size)
+        {
+            return i;
+        }
+    }
+    return (size_t)-1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, response_file)
+{
+    char const * const path = "xo-args-test-response.rsp";
+    ASSERT_TRUE(_test_write_file(path,
+                                 "--foo \"hello world\"\n"
+                                 "--ids 1 2\t3\r\n"
+                                 "--quoted it\\'s' a 'b\\\"c\n"
+                                 "--empty ''\n"));
+    char const * argv[] = {"/mock/test.ext", "@xo-args-test-response.rsp",
+                           "--bar"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(
+        utest_fixture, argv, XO_ARGS_CTX_RESPONSE_FILES);
+
+    xo_args_arg const * foo = xo_args_declare_arg(
+        utest_fixture->context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_STRING);
+    xo_args_arg const * ids = xo_args_declare_arg(utest_fixture->context,
+                                                  "ids",
+                                                  NULL,
+                                                  NULL,
+                                                  NULL,
+                                                  XO_ARGS_TYPE_INT_ARRAY);
+    xo_args_arg const * quoted = xo_args_declare_arg(utest_fixture->context,
+                                                     "quoted",
+                                                     NULL,
+                                                     NULL,
+                                                     NULL,
+                                                     XO_ARGS_TYPE_STRING);
+    xo_args_arg const * empty = xo_args_declare_arg(
+        utest_fixture->context, "empty", NULL, NULL, NULL, XO_ARGS_TYPE_STRING);
+    xo_args_arg const * bar = xo_args_declare_arg(
+        utest_fixture->context, "bar", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+    bool const submitted = xo_args_submit(utest_fixture->context);
+    // Remove the file before anything can fail so a failed test does not
+    // leave it behind. It has been loaded by now.
+    ASSERT_EQ(0, remove(path));
+    ASSERT_TRUE(submitted);
+
+    char const * foo_value = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(foo, &foo_value));
+    ASSERT_STREQ("hello world", foo_value);
+
+    int64_t const * ids_values = NULL;
+    size_t ids_count = 0;
+    ASSERT_TRUE(xo_args_try_get_int_array(ids, &ids_values, &ids_count));
+    ASSERT_EQ(3u, ids_count);
+    ASSERT_EQ(1, ids_values[0]);
+    ASSERT_EQ(2, ids_values[1]);
+    ASSERT_EQ(3, ids_values[2]);
+
+    char const * quoted_value = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(quoted, &quoted_value));
+    ASSERT_STREQ("it's a b\"c", quoted_value);
+    // String values point into the loaded response file rather than being
+    // copied. The file is either mapped (not a tracked allocation) or read
+    // into one tracked buffer, so both values are in the same place.
+    ASSERT_EQ(_test_find_allocation(foo_value),
+              _test_find_allocation(quoted_value));
+
+    char const * empty_value = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(empty, &empty_value));
+    ASSERT_STREQ("", empty_value);
+
+    bool bar_value = false;
+    ASSERT_TRUE(xo_args_try_get_bool(bar, &bar_value));
+    ASSERT_TRUE(bar_value);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The last argument of a file with no trailing whitespace has nowhere to put a
+// null terminator in place.
+UTEST_F(getters, response_file_no_trailing_whitespace)
+{
+    char const * const path = "xo-args-test-response.rsp";
+    ASSERT_TRUE(_test_write_file(path, "--foo last"));
+    char const * argv[] = {"/mock/test.ext", "@xo-args-test-response.rsp"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(
+        utest_fixture, argv, XO_ARGS_CTX_RESPONSE_FILES);
+
+    xo_args_arg const * foo = xo_args_declare_arg(
+        utest_fixture->context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_STRING);
+    bool const submitted = xo_args_submit(utest_fixture->context);
+    ASSERT_EQ(0, remove(path));
+    ASSERT_TRUE(submitted);
+
+    char const * foo_value = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(foo, &foo_value));
+    ASSERT_STREQ("last", foo_value);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, response_file_nested)
+{
+    ASSERT_TRUE(_test_write_file("xo-args-test-outer.rsp",
+                                 "--foo a @xo-args-test-inner.rsp --bar"));
+    ASSERT_TRUE(_test_write_file("xo-args-test-inner.rsp", "--foo b\n"));
+    char const * argv[] = {
+        "/mock/test.ext", "--foo", "first", "@xo-args-test-outer.rsp"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(
+        utest_fixture, argv, XO_ARGS_CTX_RESPONSE_FILES);
+
+    xo_args_arg const * foo = xo_args_declare_arg(utest_fixture->context,
+                                                  "foo",
+                                                  NULL,
+                                                  NULL,
+                                                  NULL,
+                                                  XO_ARGS_TYPE_STRING_ARRAY);
+    xo_args_arg const * bar = xo_args_declare_arg(
+        utest_fixture->context, "bar", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+    bool const submitted = xo_args_submit(utest_fixture->context);
+    ASSERT_EQ(0, remove("xo-args-test-outer.rsp"));
+    ASSERT_EQ(0, remove("xo-args-test-inner.rsp"));
+    ASSERT_TRUE(submitted);
+
+    char const ** foo_values = NULL;
+    size_t foo_count = 0;
+    ASSERT_TRUE(xo_args_try_get_string_array(foo, &foo_values, &foo_count));
+    ASSERT_EQ(3u, foo_count);
+    ASSERT_STREQ("first", foo_values[0]);
+    ASSERT_STREQ("a", foo_values[1]);
+    ASSERT_STREQ("b", foo_values[2]);
+
+    bool bar_value = false;
+    ASSERT_TRUE(xo_args_try_get_bool(bar, &bar_value));
+    ASSERT_TRUE(bar_value);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Like GCC, an @path that can not be read is an ordinary argument.
+UTEST_F(getters, response_file_missing)
+{
+    char const * argv[] = {
+        "/mock/test.ext", "--foo", "@xo-args-test-missing.rsp"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(
+        utest_fixture, argv, XO_ARGS_CTX_RESPONSE_FILES);
+
+    xo_args_arg const * foo = xo_args_declare_arg(
+        utest_fixture->context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_STRING);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    char const * foo_value = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(foo, &foo_value));
+    ASSERT_STREQ("@xo-args-test-missing.rsp", foo_value);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, response_file_disabled)
+{
+    char const * const path = "xo-args-test-response.rsp";
+    ASSERT_TRUE(_test_write_file(path, "--foo\n"));
+    char const * argv[] = {"/mock/test.ext", "@xo-args-test-response.rsp"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_declare_arg(
+        utest_fixture->context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+    bool const submitted = xo_args_submit(utest_fixture->context);
+    ASSERT_EQ(0, remove(path));
+    ASSERT_FALSE(submitted);
+
+    _test_destroy_context(utest_fixture);
+    _TEST_EXPECT_STDOUT(
+        "Error: unknown argument \"@xo-args-test-response.rsp\"");
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, response_file_recursive)
+{
+    char const * const path = "xo-args-test-response.rsp";
+    ASSERT_TRUE(_test_write_file(path, "--foo @xo-args-test-response.rsp\n"));
+    char const * argv[] = {"/mock/test.ext", "@xo-args-test-response.rsp"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(
+        utest_fixture, argv, XO_ARGS_CTX_RESPONSE_FILES);
+
+    xo_args_declare_arg(utest_fixture->context,
+                        "foo",
+                        NULL,
+                        NULL,
+                        NULL,
+                        XO_ARGS_TYPE_SWITCH);
+    bool const submitted = xo_args_submit(utest_fixture->context);
+    ASSERT_EQ(0, remove(path));
+    ASSERT_FALSE(submitted);
+
+    _test_destroy_context(utest_fixture);
+    _TEST_EXPECT_STDOUT("Error: response files are nested more than 16 deep "
+                        "at \"@xo-args-test-response.rsp\"");
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, feed)
+{
+    char const * argv[] = {"/mock/test.ext", "--foo", "1"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg const * foo = xo_args_declare_arg(
+        utest_fixture->context, "foo", "f", NULL, NULL, XO_ARGS_TYPE_INT_ARRAY);
+    xo_args_arg const * name = xo_args_declare_arg(
+        utest_fixture->context, "name", NULL, NULL, NULL, XO_ARGS_TYPE_STRING);
+    xo_args_arg const * bar = xo_args_declare_arg(
+        utest_fixture->context, "bar", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+
+    // The array started in argv keeps growing with fed values.
+    ASSERT_TRUE(xo_args_feed(utest_fixture->context, "2"));
+    ASSERT_TRUE(xo_args_feed(utest_fixture->context, "3,4"));
+    ASSERT_TRUE(xo_args_feed(utest_fixture->context, "--name"));
+
+    // Fed tokens are not referenced after xo_args_feed returns.
+    char token[16];
+    strcpy(token, "xo");
+    ASSERT_TRUE(xo_args_feed(utest_fixture->context, token));
+    strcpy(token, "overwritten");
+
+    ASSERT_TRUE(xo_args_feed(utest_fixture->context, "--bar"));
+    ASSERT_TRUE(xo_args_feed(utest_fixture->context, "-f=5"));
+    ASSERT_TRUE(xo_args_finish(utest_fixture->context));
+
+    int64_t const * foo_values = NULL;
+    size_t foo_count = 0;
+    ASSERT_TRUE(xo_args_try_get_int_array(foo, &foo_values, &foo_count));
+    ASSERT_EQ(5u, foo_count);
+    for (size_t i = 0; i < foo_count; ++i)
+    {
+        ASSERT_EQ((int64_t)i + 1, foo_values[i]);
+    }
+
+    char const * name_value = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(name, &name_value));
+    ASSERT_STREQ("xo", name_value);
+
+    bool bar_value = false;
+    ASSERT_TRUE(xo_args_try_get_bool(bar, &bar_value));
+    ASSERT_TRUE(bar_value);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, feed_invalid)
+{
+    char const * argv[] = {"/mock/test.ext"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_declare_arg(
+        utest_fixture->context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_INT);
+
+    ASSERT_TRUE(xo_args_feed(utest_fixture->context, "--foo"));
+    ASSERT_FALSE(xo_args_feed(utest_fixture->context, "x"));
+    // Once a token is invalid nothing more is parsed.
+    ASSERT_FALSE(xo_args_feed(utest_fixture->context, "--foo"));
+    ASSERT_FALSE(xo_args_finish(utest_fixture->context));
+
+    _test_destroy_context(utest_fixture);
+    _TEST_EXPECT_STDOUT("Value for --foo is not a valid integer");
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, feed_missing_value)
+{
+    char const * argv[] = {"/mock/test.ext"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_declare_arg(
+        utest_fixture->context, "foo", "f", NULL, NULL, XO_ARGS_TYPE_STRING);
+
+    ASSERT_TRUE(xo_args_feed(utest_fixture->context, "-f"));
+    ASSERT_FALSE(xo_args_finish(utest_fixture->context));
+
+    _test_destroy_context(utest_fixture);
+    _TEST_EXPECT_STDOUT("No value provided for -f");
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, finish_without_feed)
+{
+    char const * argv[] = {"/mock/test.ext", "--foo", "a", "b"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg const * foo = xo_args_declare_arg(utest_fixture->context,
+                                                  "foo",
+                                                  NULL,
+                                                  NULL,
+                                                  NULL,
+                                                  XO_ARGS_TYPE_STRING_ARRAY);
+    ASSERT_TRUE(xo_args_finish(utest_fixture->context));
+
+    char const ** foo_values = NULL;
+    size_t foo_count = 0;
+    ASSERT_TRUE(xo_args_try_get_string_array(foo, &foo_values, &foo_count));
+    ASSERT_EQ(2u, foo_count);
+    ASSERT_STREQ("a", foo_values[0]);
+    ASSERT_STREQ("b", foo_values[1]);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, reset_values)
+{
+    char const * argv[] = {"/mock/test.ext",
+                           "--foo",
+                           "1",
+                           "2",
+                           "--name",
+                           "first",
+                           "--names",
+                           "a",
+                           "b",
+                           "--bar"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg const * foo = xo_args_declare_arg(utest_fixture->context,
+                                                  "foo",
+                                                  NULL,
+                                                  NULL,
+                                                  NULL,
+                                                  XO_ARGS_TYPE_INT_ARRAY);
+    xo_args_arg const * name = xo_args_declare_arg(
+        utest_fixture->context, "name", NULL, NULL, NULL, XO_ARGS_TYPE_STRING);
+    xo_args_arg const * names = xo_args_declare_arg(utest_fixture->context,
+                                                    "names",
+                                                    NULL,
+                                                    NULL,
+                                                    NULL,
+                                                    XO_ARGS_TYPE_STRING_ARRAY);
+    xo_args_arg const * bar = xo_args_declare_arg(
+        utest_fixture->context, "bar", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    char const * second_argv[] = {
+        "/mock/test.ext", "--names", "c", "--foo", "3", "--name", "second"};
+    char const * third_argv[] = {
+        "/mock/test.ext", "--names", "d", "--foo", "4", "--name", "third!"};
+    size_t allocations_after_second = 0;
+    for (int parse = 0; parse < 2; ++parse)
+    {
+        char const ** const next_argv = 0 == parse ? second_argv : third_argv;
+        xo_args_reset_values(
+            utest_fixture->context, 7, (xo_argv_t)next_argv);
+        ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+        int64_t const * foo_values = NULL;
+        size_t foo_count = 0;
+        ASSERT_TRUE(xo_args_try_get_int_array(foo, &foo_values, &foo_count));
+        ASSERT_EQ(1u, foo_count);
+        ASSERT_EQ(3 + parse, foo_values[0]);
+
+        char const * name_value = NULL;
+        ASSERT_TRUE(xo_args_try_get_string(name, &name_value));
+        ASSERT_STREQ(next_argv[6], name_value);
+
+        char const ** names_values = NULL;
+        size_t names_count = 0;
+        ASSERT_TRUE(
+            xo_args_try_get_string_array(names, &names_values, &names_count));
+        ASSERT_EQ(1u, names_count);
+        ASSERT_STREQ(next_argv[2], names_values[0]);
+
+        bool bar_value = true;
+        ASSERT_TRUE(xo_args_try_get_bool(bar, &bar_value));
+        ASSERT_FALSE(bar_value);
+
+        // Parsing again reuses the memory of the previous parse.
+        size_t allocation_count = 0;
+        test_get_allocations(&allocation_count);
+        if (0 == parse)
+        {
+            allocations_after_second = allocation_count;
+        }
+        else
+        {
+            ASSERT_EQ(allocations_after_second, allocation_count);
+        }
+    }
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, reset_values_after_error)
+{
+    char const * argv[] = {"/mock/test.ext", "--foo", "x"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg const * foo = xo_args_declare_arg(
+        utest_fixture->context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_INT);
+    ASSERT_FALSE(xo_args_submit(utest_fixture->context));
+    ASSERT_NE(NULL, strstr(test_get_stdout(), "is not a valid integer"));
+
+    char const * second_argv[] = {"/mock/test.ext", "--foo=7"};
+    xo_args_reset_values(utest_fixture->context, 2, (xo_argv_t)second_argv);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    int64_t foo_value = 0;
+    ASSERT_TRUE(xo_args_try_get_int(foo, &foo_value));
+    ASSERT_EQ(7, foo_value);
+
+    _test_destroy_context(utest_fixture);
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, declare_args)
+{
+    static xo_args_arg_desc const descs[] = {
+        {"verbose", "V", NULL, "Print more", XO_ARGS_TYPE_SWITCH},
+        {"timeout", "t", "SECONDS", NULL, XO_ARGS_TYPE_DOUBLE},
+        {"input", "i", NULL, NULL, XO_ARGS_TYPE_STRING_ARRAY},
+        {"count", NULL, NULL, NULL, XO_ARGS_TYPE_INT_ARRAY},
+        {"output", "o", NULL, NULL, 0},
+    };
+    enum
+    {
+        DESC_COUNT = sizeof(descs) / sizeof(descs[0])
+    };
+
+    char const * argv[] = {"/mock/test.ext",
+                           "-V",
+                           "-t=2.5",
+                           "--input",
+                           "a",
+                           "b",
+                           "--count=1,2,3",
+                           "-o",
+                           "out.txt"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    size_t allocations_before = 0;
+    test_get_allocations(&allocations_before);
+
+    xo_args_arg * args[DESC_COUNT];
+    ASSERT_TRUE(xo_args_declare_args(
+        utest_fixture->context, descs, DESC_COUNT, args));
+
+    // The strings are borrowed and every argument shares one allocation. The
+    // only other allocation is the name index which is built while checking
+    // for conflicts.
+    size_t allocations_after = 0;
+    test_get_allocations(&allocations_after);
+    ASSERT_EQ(allocations_before + 2, allocations_after);
+
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    bool verbose = false;
+    ASSERT_TRUE(xo_args_try_get_bool(args[0], &verbose));
+    ASSERT_TRUE(verbose);
+
+    double timeout = 0.0;
+    ASSERT_TRUE(xo_args_try_get_double(args[1], &timeout));
+    ASSERT_EQ(2.5, timeout);
+
+    char const ** inputs = NULL;
+    size_t input_count = 0;
+    ASSERT_TRUE(
+        xo_args_try_get_string_array(args[2], &inputs, &input_count));
+    ASSERT_EQ(2u, input_count);
+    ASSERT_STREQ("a", inputs[0]);
+    ASSERT_STREQ("b", inputs[1]);
+
+    int64_t const * counts = NULL;
+    size_t count_count = 0;
+    ASSERT_TRUE(xo_args_try_get_int_array(args[3], &counts, &count_count));
+    ASSERT_EQ(3u, count_count);
+    ASSERT_EQ(3, counts[2]);
+
+    char const * output = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(args[4], &output));
+    ASSERT_STREQ("out.txt", output);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, declare_args_help_text)
+{
+    static xo_args_arg_desc const descs[] = {
+        {"timeout", "t", "SECONDS", "How long to wait", XO_ARGS_TYPE_DOUBLE},
+    };
+
+    char const * argv[] = {"/mock/test.ext", "--help"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    ASSERT_TRUE(xo_args_declare_args(utest_fixture->context, descs, 1, NULL));
+    ASSERT_FALSE(xo_args_submit(utest_fixture->context));
+
+    _test_destroy_context(utest_fixture);
+
+    _TEST_EXPECT_STDOUT("--timeout, -t SECONDS");
+    ASSERT_NE(NULL, strstr(test_get_stdout(), "How long to wait"));
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, declare_args_conflict)
+{
+    static xo_args_arg_desc const name_conflict[] = {
+        {"foo", "f", NULL, NULL, XO_ARGS_TYPE_SWITCH},
+        {"bar", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH},
+        {"foo", NULL, NULL, NULL, XO_ARGS_TYPE_INT},
+    };
+    static xo_args_arg_desc const short_name_conflict[] = {
+        {"foo", "f", NULL, NULL, XO_ARGS_TYPE_SWITCH},
+        {"bar", "f", NULL, NULL, XO_ARGS_TYPE_SWITCH},
+    };
+
+    char const * argv[] = {"/mock/test.ext", "--baz"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    ASSERT_FALSE(
+        xo_args_declare_args(utest_fixture->context, name_conflict, 3, NULL));
+    ASSERT_NE(NULL,
+              strstr(test_get_stdout(), "argument name conflict. name: foo"));
+    ASSERT_FALSE(xo_args_declare_args(
+        utest_fixture->context, short_name_conflict, 2, NULL));
+    ASSERT_NE(NULL, strstr(test_get_stdout(), "short_name: f"));
+
+    // Nothing from the failed tables was declared.
+    xo_args_arg const * baz = xo_args_declare_arg(
+        utest_fixture->context, "baz", "f", NULL, NULL, XO_ARGS_TYPE_SWITCH);
+    ASSERT_NE(NULL, (void *)baz);
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    bool baz_value = false;
+    ASSERT_TRUE(xo_args_try_get_bool(baz, &baz_value));
+    ASSERT_TRUE(baz_value);
+
+    _test_destroy_context(utest_fixture);
+    _TEST_EXPECT_STDOUT("conflict");
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, declare_args_conflict_with_existing)
+{
+    static xo_args_arg_desc const descs[] = {
+        {"bar", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH},
+        {"foo", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH},
+    };
+
+    char const * argv[] = {"/mock/test.ext", "--foo"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg const * foo = xo_args_declare_arg(
+        utest_fixture->context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+    ASSERT_FALSE(xo_args_declare_args(utest_fixture->context, descs, 2, NULL));
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+
+    bool foo_value = false;
+    ASSERT_TRUE(xo_args_try_get_bool(foo, &foo_value));
+    ASSERT_TRUE(foo_value);
+
+    _test_destroy_context(utest_fixture);
+    _TEST_EXPECT_STDOUT("argument name conflict. name: foo");
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, declare_args_invalid)
+{
+    static xo_args_arg_desc const descs[] = {
+        {"foo", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH},
+        {"b@r", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH},
+    };
+
+    char const * argv[] = {"/mock/test.ext"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg * args[2] = {NULL, NULL};
+    ASSERT_FALSE(xo_args_declare_args(utest_fixture->context, descs, 2, args));
+    ASSERT_EQ(NULL, (void *)args[0]);
+    ASSERT_EQ(1u, test_get_assert_count());
+
+    _test_destroy_context(utest_fixture);
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, bind_values)
+{
+    char const * argv[] = {"/mock/test.ext",
+                           "--string",
+                           "text",
+                           "--int=-5",
+                           "-d",
+                           "2.5",
+                           "--bool",
+                           "true",
+                           "--switch"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+    xo_args_ctx * const ctx = utest_fixture->context;
+
+    xo_args_arg * string_arg = xo_args_declare_arg(
+        ctx, "string", NULL, NULL, NULL, XO_ARGS_TYPE_STRING);
+    xo_args_arg * int_arg =
+        xo_args_declare_arg(ctx, "int", NULL, NULL, NULL, XO_ARGS_TYPE_INT);
+    xo_args_arg * double_arg = xo_args_declare_arg(
+        ctx, "double", "d", NULL, NULL, XO_ARGS_TYPE_DOUBLE);
+    xo_args_arg * bool_arg =
+        xo_args_declare_arg(ctx, "bool", NULL, NULL, NULL, XO_ARGS_TYPE_BOOL);
+    xo_args_arg * switch_arg = xo_args_declare_arg(
+        ctx, "switch", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+    xo_args_arg * unused_arg =
+        xo_args_declare_arg(ctx, "unused", NULL, NULL, NULL, XO_ARGS_TYPE_INT);
+
+    char const * string_value = NULL;
+    int64_t int_value = 0;
+    double double_value = 0.0;
+    bool bool_value = false;
+    bool switch_value = false;
+    int64_t unused_value = 42;
+    xo_args_bind_string(string_arg, &string_value);
+    xo_args_bind_int(int_arg, &int_value);
+    xo_args_bind_double(double_arg, &double_value);
+    xo_args_bind_bool(bool_arg, &bool_value);
+    xo_args_bind_bool(switch_arg, &switch_value);
+    xo_args_bind_int(unused_arg, &unused_value);
+
+    ASSERT_TRUE(xo_args_submit(ctx));
+    ASSERT_STREQ("text", string_value);
+    ASSERT_EQ(-5, int_value);
+    ASSERT_EQ(2.5, double_value);
+    ASSERT_TRUE(bool_value);
+    ASSERT_TRUE(switch_value);
+    // Arguments that are not given keep their defaults.
+    ASSERT_EQ(42, unused_value);
+
+    // The bound string is the one the getter returns.
+    char const * got_string = NULL;
+    ASSERT_TRUE(xo_args_try_get_string(string_arg, &got_string));
+    ASSERT_EQ(got_string, string_value);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, bind_failed_submit)
+{
+    char const * argv[] = {
+        "/mock/test.ext", "--int", "5", "--switch", "--ints", "1", "--bad=x"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+    xo_args_ctx * const ctx = utest_fixture->context;
+
+    xo_args_arg * int_arg =
+        xo_args_declare_arg(ctx, "int", NULL, NULL, NULL, XO_ARGS_TYPE_INT);
+    xo_args_arg * switch_arg = xo_args_declare_arg(
+        ctx, "switch", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+    xo_args_arg * ints_arg = xo_args_declare_arg(
+        ctx, "ints", NULL, NULL, NULL, XO_ARGS_TYPE_INT_ARRAY);
+    xo_args_declare_arg(ctx, "bad", NULL, NULL, NULL, XO_ARGS_TYPE_INT);
+
+    int64_t int_value = 42;
+    bool switch_value = false;
+    int64_t const * ints_values = NULL;
+    size_t ints_count = 0;
+    xo_args_bind_int(int_arg, &int_value);
+    xo_args_bind_bool(switch_arg, &switch_value);
+    xo_args_bind_int_array(ints_arg, &ints_values, &ints_count);
+
+    // Values parsed before the invalid one are not written either.
+    ASSERT_FALSE(xo_args_submit(ctx));
+    ASSERT_EQ(42, int_value);
+    ASSERT_FALSE(switch_value);
+    ASSERT_EQ(NULL, (void *)ints_values);
+    ASSERT_EQ(0u, ints_count);
+
+    _test_destroy_context(utest_fixture);
+    _TEST_EXPECT_STDOUT("Value for --bad is not a valid integer");
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, bind_arrays)
+{
+    char const * argv[] = {"/mock/test.ext",
+                           "--strings",
+                           "a",
+                           "b",
+                           "--ints",
+                           "1,2,3",
+                           "--doubles",
+                           "0.5",
+                           "--bools",
+                           "false",
+                           "true",
+                           "--strings",
+                           "c"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+    xo_args_ctx * const ctx = utest_fixture->context;
+
+    xo_args_arg * strings_arg = xo_args_declare_arg(
+        ctx, "strings", NULL, NULL, NULL, XO_ARGS_TYPE_STRING_ARRAY);
+    xo_args_arg * ints_arg = xo_args_declare_arg(
+        ctx, "ints", NULL, NULL, NULL, XO_ARGS_TYPE_INT_ARRAY);
+    xo_args_arg * doubles_arg = xo_args_declare_arg(
+        ctx, "doubles", NULL, NULL, NULL, XO_ARGS_TYPE_DOUBLE_ARRAY);
+    xo_args_arg * bools_arg = xo_args_declare_arg(
+        ctx, "bools", NULL, NULL, NULL, XO_ARGS_TYPE_BOOL_ARRAY);
+    xo_args_arg * unused_arg = xo_args_declare_arg(
+        ctx, "unused", NULL, NULL, NULL, XO_ARGS_TYPE_INT_ARRAY);
+
+    char const ** strings = NULL;
+    int64_t const * ints = NULL;
+    double const * doubles = NULL;
+    bool const * bools = NULL;
+    int64_t const * unused = NULL;
+    size_t strings_count = 0;
+    size_t ints_count = 0;
+    size_t doubles_count = 0;
+    size_t bools_count = 0;
+    size_t unused_count = 7;
+    xo_args_bind_string_array(strings_arg, &strings, &strings_count);
+    xo_args_bind_int_array(ints_arg, &ints, &ints_count);
+    xo_args_bind_double_array(doubles_arg, &doubles, &doubles_count);
+    xo_args_bind_bool_array(bools_arg, &bools, &bools_count);
+    xo_args_bind_int_array(unused_arg, &unused, &unused_count);
+
+    ASSERT_TRUE(xo_args_submit(ctx));
+    ASSERT_EQ(3u, strings_count);
+    ASSERT_STREQ("a", strings[0]);
+    ASSERT_STREQ("b", strings[1]);
+    ASSERT_STREQ("c", strings[2]);
+    ASSERT_EQ(3u, ints_count);
+    ASSERT_EQ(3, ints[2]);
+    ASSERT_EQ(1u, doubles_count);
+    ASSERT_EQ(0.5, doubles[0]);
+    ASSERT_EQ(2u, bools_count);
+    ASSERT_FALSE(bools[0]);
+    ASSERT_TRUE(bools[1]);
+    ASSERT_EQ(NULL, (void const *)unused);
+    ASSERT_EQ(7u, unused_count);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, bind_wrong_type)
+{
+    char const * argv[] = {"/mock/test.ext", "--foo", "1"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg * foo = xo_args_declare_arg(
+        utest_fixture->context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_INT);
+    double value = 0.0;
+    xo_args_bind_double(foo, &value);
+    ASSERT_EQ(1u, test_get_assert_count());
+
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+    ASSERT_EQ(0.0, value);
+
+    _test_destroy_context(utest_fixture);
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Adds every int64_t value to the int64_t pointed to by user_data and rejects
+// negative values.
+static bool _test_sum_values(xo_args_arg const * const arg,
+                             void const * const value,
+                             void * const user_data)
+{
+    (void)arg;
+    int64_t const int_value = *(int64_t const *)value;
+    *(int64_t *)user_data += int_value;
+    return int_value >= 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Appends every string value to the buffer pointed to by user_data.
+static bool _test_join_values(xo_args_arg const * const arg,
+                              void const * const value,
+                              void * const user_data)
+{
+    (void)arg;
+    strcat((char *)user_data, *(char const * const *)value);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, value_callback)
+{
+    char const * argv[] = {"/mock/test.ext",
+                           "--ints",
+                           "1,2,3",
+                           "4",
+                           "--strings",
+                           "a",
+                           "b",
+                           "--ints=5",
+                           "-s",
+                           "c"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg * ints = xo_args_declare_arg(utest_fixture->context,
+                                             "ints",
+                                             NULL,
+                                             NULL,
+                                             NULL,
+                                             XO_ARGS_TYPE_INT_ARRAY
+                                                 | XO_ARGS_ARG_REQUIRED);
+    xo_args_arg * strings = xo_args_declare_arg(utest_fixture->context,
+                                                "strings",
+                                                "s",
+                                                NULL,
+                                                NULL,
+                                                XO_ARGS_TYPE_STRING_ARRAY);
+    int64_t sum = 0;
+    char joined[16] = "";
+    xo_args_set_value_callback(ints, _test_sum_values, &sum);
+    xo_args_set_value_callback(strings, _test_join_values, joined);
+
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+    ASSERT_EQ(15, sum);
+    ASSERT_STREQ("abc", joined);
+
+    // The values were handed over instead of stored.
+    int64_t const * values = NULL;
+    size_t count = 1;
+    ASSERT_TRUE(xo_args_try_get_int_array(ints, &values, &count));
+    ASSERT_EQ(0u, count);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, value_callback_rejects)
+{
+    char const * argv[] = {"/mock/test.ext", "--ints", "1", "-2", "3"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg * ints = xo_args_declare_arg(utest_fixture->context,
+                                             "ints",
+                                             NULL,
+                                             NULL,
+                                             NULL,
+                                             XO_ARGS_TYPE_INT_ARRAY);
+    int64_t sum = 0;
+    xo_args_set_value_callback(ints, _test_sum_values, &sum);
+
+    ASSERT_FALSE(xo_args_submit(utest_fixture->context));
+    // Parsing stops at the rejected value.
+    ASSERT_EQ(-1, sum);
+
+    _test_destroy_context(utest_fixture);
+    _TEST_EXPECT_STDOUT("Error: Value rejected for --ints");
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, schema)
+{
+    char const * schema_argv[] = {"/mock/test.ext"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(
+        utest_fixture, schema_argv, XO_ARGS_CTX_CACHE_HELP);
+    xo_args_ctx * const schema = utest_fixture->context;
+
+    xo_args_arg * count_arg =
+        xo_args_declare_arg(schema, "count", "c", NULL, NULL, XO_ARGS_TYPE_INT);
+    xo_args_arg * names_arg = xo_args_declare_arg(
+        schema, "names", "n", NULL, NULL, XO_ARGS_TYPE_STRING_ARRAY);
+    ASSERT_TRUE(xo_args_freeze_schema(schema));
+
+    char const * argv_a[] = {"/mock/a.ext", "--count", "1", "-n", "x", "y"};
+    char const * argv_b[] = {"/mock/b.ext", "-c=2"};
+    xo_args_ctx * const a = xo_args_create_ctx_from_schema(
+        schema, 6, (xo_argv_t)argv_a);
+    xo_args_ctx * const b = xo_args_create_ctx_from_schema(
+        schema, 2, (xo_argv_t)argv_b);
+    ASSERT_NE(NULL, (void *)a);
+    ASSERT_NE(NULL, (void *)b);
+    ASSERT_TRUE(xo_args_submit(a));
+    ASSERT_TRUE(xo_args_submit(b));
+
+    int64_t count = 0;
+    ASSERT_TRUE(
+        xo_args_try_get_int(xo_args_get_schema_arg(a, count_arg), &count));
+    ASSERT_EQ(1, count);
+    ASSERT_TRUE(
+        xo_args_try_get_int(xo_args_get_schema_arg(b, count_arg), &count));
+    ASSERT_EQ(2, count);
+
+    char const ** names = NULL;
+    size_t names_count = 0;
+    ASSERT_TRUE(xo_args_try_get_string_array(
+        xo_args_get_schema_arg(a, names_arg), &names, &names_count));
+    ASSERT_EQ(2u, names_count);
+    ASSERT_STREQ("y", names[1]);
+    ASSERT_FALSE(xo_args_try_get_string_array(
+        xo_args_get_schema_arg(b, names_arg), &names, &names_count));
+
+    // The schema itself never has values.
+    ASSERT_FALSE(xo_args_try_get_int(count_arg, &count));
+    ASSERT_EQ((void *)count_arg,
+              (void *)xo_args_get_schema_arg(schema, count_arg));
+
+    // Contexts created from a schema can be parsed again like any other.
+    char const * argv_c[] = {"/mock/c.ext", "--count", "3"};
+    xo_args_reset_values(b, 3, (xo_argv_t)argv_c);
+    ASSERT_TRUE(xo_args_submit(b));
+    ASSERT_TRUE(
+        xo_args_try_get_int(xo_args_get_schema_arg(b, count_arg), &count));
+    ASSERT_EQ(3, count);
+
+    xo_args_destroy_ctx(a);
+    xo_args_destroy_ctx(b);
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, schema_help)
+{
+    char const * schema_argv[] = {"/mock/test.ext"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(
+        utest_fixture, schema_argv, XO_ARGS_CTX_CACHE_HELP);
+    xo_args_declare_arg(utest_fixture->context,
+                        "count",
+                        "c",
+                        NULL,
+                        "how many",
+                        XO_ARGS_TYPE_INT);
+    ASSERT_TRUE(xo_args_freeze_schema(utest_fixture->context));
+
+    char const * argv[] = {"/mock/job.ext", "--help"};
+    xo_args_ctx * const job = xo_args_create_ctx_from_schema(
+        utest_fixture->context, 2, (xo_argv_t)argv);
+    ASSERT_FALSE(xo_args_submit(job));
+    xo_args_destroy_ctx(job);
+
+    _test_destroy_context(utest_fixture);
+    _TEST_EXPECT_STDOUT("how many");
+    // The app name comes from the schema, not the job's argv.
+    ASSERT_NE(NULL, strstr(test_get_stdout(), "test"));
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, schema_is_read_only)
+{
+    char const * argv[] = {"/mock/test.ext"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+    xo_args_ctx * const schema = utest_fixture->context;
+    ASSERT_TRUE(xo_args_freeze_schema(schema));
+
+    ASSERT_EQ(NULL,
+              (void *)xo_args_declare_arg(
+                  schema, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_INT));
+    ASSERT_EQ(1u, test_get_assert_count());
+    ASSERT_FALSE(xo_args_submit(schema));
+    ASSERT_EQ(2u, test_get_assert_count());
+
+    xo_args_ctx * const job =
+        xo_args_create_ctx_from_schema(schema, 1, (xo_argv_t)argv);
+    ASSERT_EQ(NULL,
+              (void *)xo_args_declare_arg(
+                  job, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_INT));
+    ASSERT_EQ(3u, test_get_assert_count());
+    ASSERT_FALSE(xo_args_freeze_schema(job));
+    ASSERT_EQ(4u, test_get_assert_count());
+    ASSERT_TRUE(xo_args_submit(job));
+
+    xo_args_destroy_ctx(job);
+    _test_destroy_context(utest_fixture);
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, schema_can_not_parse)
+{
+    char const * argv[] = {"/mock/test.ext", "--foo", "1"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+    xo_args_ctx * const schema = utest_fixture->context;
+    xo_args_arg const * const foo =
+        xo_args_declare_arg(schema, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_INT);
+    ASSERT_TRUE(xo_args_freeze_schema(schema));
+
+    // Each call is refused before it touches the schema.
+    ASSERT_FALSE(xo_args_feed(schema, "--foo"));
+    ASSERT_EQ(1u, test_get_assert_count());
+    ASSERT_FALSE(xo_args_finish(schema));
+    ASSERT_EQ(2u, test_get_assert_count());
+    ASSERT_FALSE(xo_args_finish(schema));
+    ASSERT_EQ(3u, test_get_assert_count());
+    xo_args_reset_values(schema, 3, (xo_argv_t)argv);
+    ASSERT_EQ(4u, test_get_assert_count());
+    ASSERT_FALSE(xo_args_submit(schema));
+    ASSERT_EQ(5u, test_get_assert_count());
+    int64_t value = 0;
+    ASSERT_FALSE(xo_args_try_get_int(foo, &value));
+
+    // The schema still works for contexts created from it.
+    xo_args_ctx * const job =
+        xo_args_create_ctx_from_schema(schema, 3, (xo_argv_t)argv);
+    ASSERT_TRUE(xo_args_submit(job));
+    ASSERT_TRUE(
+        xo_args_try_get_int(xo_args_get_schema_arg(job, foo), &value));
+    ASSERT_EQ(1, value);
+    ASSERT_EQ(5u, test_get_assert_count());
+
+    xo_args_destroy_ctx(job);
+    _test_destroy_context(utest_fixture);
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Fills jobs with a repeating mix of valid and invalid command lines: every
+// third job has an invalid value and every fifth an unknown argument.
+static void _test_make_jobs(xo_args_job * const jobs, size_t const job_count)
+{
+    static char const * valid[] = {"/mock/job.ext", "--count", "5"};
+    static char const * bad_value[] = {"/mock/job.ext", "--count", "x"};
+    static char const * unknown[] = {"/mock/job.ext", "--nope"};
+    for (size_t i = 0; i < job_count; ++i)
+    {
+        char const ** argv = valid;
+        int argc = 3;
+        if (0 == i % 5)
+        {
+            argv = unknown;
+            argc = 2;
+        }
+        else if (0 == i % 3)
+        {
+            argv = bad_value;
+        }
+        jobs[i].argc = argc;
+        jobs[i].argv = (xo_argv_t)argv;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, validate_batch)
+{
+    char const * argv[] = {"/mock/test.ext"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+    xo_args_declare_arg(
+        utest_fixture->context, "count", "c", NULL, NULL, XO_ARGS_TYPE_INT);
+    ASSERT_TRUE(xo_args_freeze_schema(utest_fixture->context));
+
+    xo_args_job jobs[200];
+    _test_make_jobs(jobs, 200);
+    // The test allocator is not thread safe so this batch uses one thread.
+    xo_args_batch * const batch =
+        xo_args_validate_batch(utest_fixture->context, jobs, 200, 1);
+    ASSERT_NE(NULL, (void *)batch);
+
+    size_t invalid = 0;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        char const * const errors = xo_args_batch_get_errors(batch, i);
+        if (0 == i % 5)
+        {
+            ASSERT_NE(NULL, strstr(errors, "unknown argument \"--nope\""));
+        }
+        else if (0 == i % 3)
+        {
+            ASSERT_NE(NULL, strstr(errors, "--count is not a valid integer"));
+        }
+        else
+        {
+            ASSERT_EQ(NULL, errors);
+            continue;
+        }
+        ++invalid;
+    }
+    ASSERT_EQ(invalid, xo_args_batch_invalid_count(batch));
+    xo_args_destroy_batch(batch);
+
+    // Errors are collected instead of printed.
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, validate_batch_threads)
+{
+    (void)utest_fixture;
+    // Worker threads allocate concurrently, so this schema uses the default
+    // allocator instead of the test allocator.
+    char const * argv[] = {"/mock/test.ext"};
+    xo_args_ctx_options options;
+    memset(&options, 0, sizeof(options));
+    options.print_fn = test_printf;
+    xo_args_ctx * const schema =
+        xo_args_create_ctx_with_options(1, (xo_argv_t)argv, &options);
+    xo_args_declare_arg(schema, "count", "c", NULL, NULL, XO_ARGS_TYPE_INT);
+    ASSERT_TRUE(xo_args_freeze_schema(schema));
+
+    size_t const job_count = 5000;
+    xo_args_job * const jobs =
+        (xo_args_job *)malloc(sizeof(xo_args_job) * job_count);
+    _test_make_jobs(jobs, job_count);
+
+    // Every thread count gives the results of one thread.
+    xo_args_batch * const serial =
+        xo_args_validate_batch(schema, jobs, job_count, 1);
+    size_t const thread_counts[] = {2, 4, 7, 0};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(*thread_counts); ++t)
+    {
+        xo_args_batch * const batch =
+            xo_args_validate_batch(schema, jobs, job_count, thread_counts[t]);
+        ASSERT_EQ(xo_args_batch_invalid_count(serial),
+                  xo_args_batch_invalid_count(batch));
+        for (size_t i = 0; i < job_count; ++i)
+        {
+            char const * const expected = xo_args_batch_get_errors(serial, i);
+            char const * const errors = xo_args_batch_get_errors(batch, i);
+            if (NULL == expected)
+            {
+                ASSERT_EQ(NULL, errors);
+            }
+            else
+            {
+                ASSERT_STREQ(expected, errors);
+            }
+        }
+        xo_args_destroy_batch(batch);
+    }
+
+    xo_args_destroy_batch(serial);
+    free(jobs);
+    xo_args_destroy_ctx(schema);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Submits "--foo" followed by values and "--bar" with foo declared as
+// array_type and its values converted by up to value_threads threads. Copies
+// foo's values and everything printed out. Returns the result of submit.
+static bool _test_submit_large_array(char const ** const values,
+                                     size_t const value_count,
+                                     XO_ARGS_ARG_FLAG const array_type,
+                                     size_t const value_threads,
+                                     int64_t * const out_values,
+                                     size_t * const out_count,
+                                     char * const out_stdout)
+{
+    size_t const argc = value_count + 3;
+    char const ** argv = (char const **)malloc(sizeof(char const *) * argc);
+    argv[0] = "/mock/test.ext";
+    argv[1] = "--foo";
+    memcpy(
+        (void *)&argv[2], (void *)values, sizeof(char const *) * value_count);
+    argv[argc - 1] = "--bar";
+
+    // The default allocator keeps the test allocator's bookkeeping out of a
+    // parse this large.
+    xo_args_ctx_options options;
+    memset(&options, 0, sizeof(options));
+    options.print_fn = test_printf;
+    options.value_threads = value_threads;
+    xo_args_ctx * const context =
+        xo_args_create_ctx_with_options((int)argc, (xo_argv_t)argv, &options);
+    xo_args_arg const * const foo =
+        xo_args_declare_arg(context, "foo", NULL, NULL, NULL, array_type);
+    xo_args_declare_arg(context, "bar", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+
+    test_global_clear();
+    bool const result = xo_args_submit(context);
+    strcpy(out_stdout, test_get_stdout());
+    test_global_clear();
+
+    *out_count = 0;
+    int64_t const * ints = NULL;
+    double const * doubles = NULL;
+    if (xo_args_try_get_int_array(foo, &ints, out_count))
+    {
+        memcpy(out_values, ints, sizeof(int64_t) * *out_count);
+    }
+    else if (xo_args_try_get_double_array(foo, &doubles, out_count))
+    {
+        memcpy(out_values, doubles, sizeof(double) * *out_count);
+    }
+    xo_args_destroy_ctx(context);
+    free((void *)argv);
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, large_array_threads)
+{
+    (void)utest_fixture;
+    size_t const value_count = 50000;
+    char const ** values =
+        (char const **)malloc(sizeof(char const *) * value_count);
+    char * storage = (char *)malloc(16 * value_count);
+    for (size_t i = 0; i < value_count; ++i)
+    {
+        char * const value = &storage[16 * i];
+        snprintf(value, 16, "%u.5", (unsigned)i);
+        values[i] = value;
+    }
+    // Lists of values are left to the serial path part way through a run.
+    values[30001] = "7,8";
+
+    // Room for one value more than there are tokens (the list holds two).
+    int64_t * const serial = (int64_t *)malloc(8 * (value_count + 1));
+    int64_t * const parallel = (int64_t *)malloc(8 * (value_count + 1));
+    char serial_stdout[256];
+    char parallel_stdout[256];
+    size_t serial_count = 0;
+    size_t parallel_count = 0;
+
+    // Every value is valid for a double array. An int array takes the
+    // integers and fails at "40000.5", in the last share of every thread count.
+    XO_ARGS_ARG_FLAG const types[] = {XO_ARGS_TYPE_DOUBLE_ARRAY,
+                                      XO_ARGS_TYPE_INT_ARRAY};
+    for (size_t t = 0; t < sizeof(types) / sizeof(*types); ++t)
+    {
+        if (XO_ARGS_TYPE_INT_ARRAY == types[t])
+        {
+            for (size_t i = 0; i < 40000; ++i)
+            {
+                snprintf(&storage[16 * i], 16, "%u", (unsigned)i);
+            }
+        }
+        bool const serial_result = _test_submit_large_array(values,
+                                                            value_count,
+                                                            types[t],
+                                                            1,
+                                                            serial,
+                                                            &serial_count,
+                                                            serial_stdout);
+        if (XO_ARGS_TYPE_DOUBLE_ARRAY == types[t])
+        {
+            ASSERT_TRUE(serial_result);
+            ASSERT_EQ(value_count + 1, serial_count);
+        }
+        else
+        {
+            ASSERT_FALSE(serial_result);
+            ASSERT_NE(NULL,
+                      strstr(serial_stdout,
+                             "Value for --foo is not a valid integer"));
+        }
+
+        size_t const thread_counts[] = {2, 3, 4, 0};
+        for (size_t c = 0; c < sizeof(thread_counts) / sizeof(*thread_counts);
+             ++c)
+        {
+            bool const result = _test_submit_large_array(values,
+                                                         value_count,
+                                                         types[t],
+                                                         thread_counts[c],
+                                                         parallel,
+                                                         &parallel_count,
+                                                         parallel_stdout);
+            ASSERT_EQ(serial_result, result);
+            ASSERT_STREQ(serial_stdout, parallel_stdout);
+            ASSERT_EQ(serial_count, parallel_count);
+            ASSERT_EQ(0, memcmp(serial, parallel, 8 * serial_count));
+        }
+    }
+
+    free(parallel);
+    free(serial);
+    free(storage);
+    free((void *)values);
+}
+
+#if defined(XO_ARGS_STATS)
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, stats)
+{
+    char const * argv[] = {
+        "/mock/test.ext", "--foo", "1", "2", "--bar=text", "-f", "3"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_stats stats;
+    xo_args_get_stats(utest_fixture->context, &stats);
+    size_t const create_allocations = stats.allocations;
+    ASSERT_EQ(0u, stats.tokens_scanned);
+    ASSERT_EQ(0u, (unsigned)stats.declare_ns);
+
+    xo_args_arg const * foo = xo_args_declare_arg(
+        utest_fixture->context, "foo", "f", NULL, NULL, XO_ARGS_TYPE_INT_ARRAY);
+    xo_args_declare_arg(
+        utest_fixture->context, "bar", NULL, NULL, NULL, XO_ARGS_TYPE_STRING);
+    xo_args_get_stats(utest_fixture->context, &stats);
+    ASSERT_GT(stats.allocations, create_allocations);
+    ASSERT_GT(stats.declare_ns, 0u);
+    ASSERT_EQ(0u, (unsigned)stats.submit_ns);
+
+    ASSERT_TRUE(xo_args_submit(utest_fixture->context));
+    xo_args_get_stats(utest_fixture->context, &stats);
+    ASSERT_EQ(6u, stats.tokens_scanned);
+    // "--foo", "--bar=text" and "-f" are looked up as arguments and
+    // "--bar=text" is looked up once more to check if it ends the --foo array.
+    // "2" can't end the array because it doesn't start with '-' and "1" and
+    // "3" are the first values of their argument. The three arguments are
+    // also looked up once each while reserving room for the array values.
+    ASSERT_EQ(7u, stats.match_attempts);
+    ASSERT_GT(stats.submit_ns, 0u);
+    ASSERT_EQ(0u, (unsigned)stats.help_ns);
+    // --foo gets room for all three of its values before any are parsed.
+    ASSERT_EQ(0u, stats.reallocations);
+    ASSERT_GE(stats.bytes_requested, stats.peak_tracked_bytes);
+    ASSERT_GT(stats.peak_tracked_bytes, 0u);
+
+    int64_t const * values = NULL;
+    size_t count = 0;
+    ASSERT_TRUE(xo_args_try_get_int_array(foo, &values, &count));
+    ASSERT_EQ(3u, count);
+
+    _test_destroy_context(utest_fixture);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, stats_help)
+{
+    char const * argv[] = {"/mock/test.ext", "--help"};
+    _TEST_INIT_CONTEXT_WITH_FLAGS(utest_fixture, argv, XO_ARGS_CTX_ARENA);
+
+    xo_args_declare_arg(
+        utest_fixture->context, "foo", "f", NULL, NULL, XO_ARGS_TYPE_INT);
+    ASSERT_FALSE(xo_args_submit(utest_fixture->context));
+
+    xo_args_stats stats;
+    xo_args_get_stats(utest_fixture->context, &stats);
+    ASSERT_EQ(1u, stats.tokens_scanned);
+    ASSERT_GT(stats.help_ns, 0u);
+    ASSERT_GE(stats.submit_ns, stats.help_ns);
+    ASSERT_GT(stats.peak_tracked_bytes, 0u);
+
+    _test_destroy_context(utest_fixture);
+    _TEST_EXPECT_STDOUT("--foo");
+    test_global_clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, stats_frozen_schema)
+{
+    char const * argv[] = {"/mock/test.ext"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+    xo_args_declare_arg(
+        utest_fixture->context, "foo", "f", NULL, NULL, XO_ARGS_TYPE_INT);
+    ASSERT_TRUE(xo_args_freeze_schema(utest_fixture->context));
+
+    // Rendering help does not write to a schema shared between threads.
+    xo_args_stats before;
+    xo_args_get_stats(utest_fixture->context, &before);
+    char help[1024];
+    ASSERT_GT(xo_args_render_help(utest_fixture->context, help, sizeof(help)),
+              0u);
+    xo_args_stats after;
+    xo_args_get_stats(utest_fixture->context, &after);
+    ASSERT_EQ(before.help_ns, after.help_ns);
+
+    _test_destroy_context(utest_fixture);
+    _TEST_EXPECT_CLEAN_SHUTDOWN();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Submits argv with an int array and a string array that each get
+// value_count values and returns the reallocations that cost.
+static size_t _test_array_reallocations(size_t const value_count)
+{
+    size_t const argc = 3 + 2 * value_count;
+    char const ** argv = (char const **)malloc(sizeof(char const *) * argc);
+    char * storage = (char *)malloc(16 * value_count);
+    argv[0] = "/mock/test.ext";
+    argv[1] = "--ints";
+    argv[2 + value_count] = "--strings";
+    for (size_t i = 0; i < value_count; ++i)
+    {
+        char * const value = &storage[16 * i];
+        snprintf(value, 16, "%u", (unsigned)i);
+        argv[2 + i] = value;
+        argv[3 + value_count + i] = value;
+    }
+
+    xo_args_ctx * context = xo_args_create_ctx_advanced((int)argc,
+                                                        (xo_argv_t)argv,
+                                                        NULL,
+                                                        NULL,
+                                                        NULL,
+                                                        test_alloc,
+                                                        test_realloc,
+                                                        test_free,
+                                                        test_printf);
+    xo_args_arg const * ints = xo_args_declare_arg(
+        context, "ints", NULL, NULL, NULL, XO_ARGS_TYPE_INT_ARRAY);
+    xo_args_arg const * strings = xo_args_declare_arg(
+        context, "strings", NULL, NULL, NULL, XO_ARGS_TYPE_STRING_ARRAY);
+    size_t reallocations = (size_t)-1;
+    if (xo_args_submit(context))
+    {
+        int64_t const * int_values = NULL;
+        char const ** string_values = NULL;
+        size_t int_count = 0;
+        size_t string_count = 0;
+        xo_args_try_get_int_array(ints, &int_values, &int_count);
+        xo_args_try_get_string_array(strings, &string_values, &string_count);
+        bool valid = value_count == int_count && value_count == string_count;
+        for (size_t i = 0; valid && i < value_count; ++i)
+        {
+            valid = (int64_t)i == int_values[i]
+                    && 0 == strcmp(argv[2 + i], string_values[i]);
+        }
+        if (valid)
+        {
+            xo_args_stats stats;
+            xo_args_get_stats(context, &stats);
+            reallocations = stats.reallocations;
+        }
+    }
+    xo_args_destroy_ctx(context);
+    free(storage);
+    free((void *)argv);
+    return reallocations;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, array_presize)
+{
+    (void)utest_fixture;
+    // Room for every value is reserved before parsing, so a thousand values
+    // grow the arrays no more often than two do.
+    size_t const few = _test_array_reallocations(2);
+    ASSERT_NE((size_t)-1, few);
+    ASSERT_EQ(few, _test_array_reallocations(1000));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST_F(getters, array_capacity_hint)
+{
+    char const * argv[] = {"/mock/test.ext"};
+    _TEST_INIT_CONTEXT(utest_fixture, argv);
+
+    xo_args_arg * foo = xo_args_declare_arg(utest_fixture->context,
+                                            "foo",
+                                            NULL,
+                                            NULL,
+                                            NULL,
+                                            XO_ARGS_TYPE_INT_ARRAY);
+    xo_args_set_capacity_hint(foo, 100);
+
+    xo_args_stats stats;
+    xo_args_get_stats(utest_fixture->context, &stats);
+    size_t const reallocations = stats.reallocations;
+
+    ASSERT_TRUE(xo_args_feed(utest_fixture->context, "--foo"));
+    for (size_t i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(xo_args_feed(utest_fixture->context, "7"));
+    }
+    ASSERT_TRUE(xo_args_finish(utest_fixture->context));
+
+    xo_args_get_stats(utest_fixture->context, &stats);
+    ASSERT_EQ(reallocations, stats.reallocations);
+
+    int64_t const * values = NULL;
+    size_t count = 0;
+    ASSERT_TRUE(xo_args_try_get_int_array(foo, &values, &count));
+    ASSERT_EQ(100u, count);
+    ASSERT_EQ(7, values[99]);
+
+    _test_destroy_context(utest_fixture);
+}
+#endif
@@ -0,0 +1,464 @@
+#include "utest.h"
+#include <ctype.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <xo-args/xo-args.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// These tests compare the values xo-args accepts against the C library
+// functions it used to be built on. Every input is parsed through the public
+// API so that both the "--foo value" and "--foo=value" forms are covered.
+
+////////////////////////////////////////////////////////////////////////////////
+// Invalid inputs print errors. We only care whether submit succeeded.
+static int _parsing_quiet_print(char const * const fmt, ...)
+{
+    (void)fmt;
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// A small xorshift generator so failures are reproducible on every platform.
+static uint64_t _parsing_next_random(uint64_t * const state)
+{
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The reference: how xo-args validated integers with strtoll.
+static bool _parsing_strtoll(char const * const input, int64_t * const out)
+{
+    if ('\0' == input[0] || isspace((unsigned char)input[0]))
+    {
+        return false;
+    }
+    errno = 0;
+    char * end_ptr;
+    long long const value = strtoll(input, &end_ptr, 0);
+    if (0 != errno || '\0' != *end_ptr || input == end_ptr
+        || value != (long long)(int64_t)value)
+    {
+        return false;
+    }
+    *out = (int64_t)value;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Parses input as the value of an argument of the given type and returns
+// whether submit succeeded. With assign the input is passed as "--foo=input",
+// otherwise as "--foo input".
+static bool _parsing_xo_args(char const * const input,
+                             bool const assign,
+                             XO_ARGS_ARG_FLAG const type,
+                             int64_t * const out_int,
+                             double * const out_double)
+{
+    static char assigned[4096];
+    snprintf(assigned, sizeof(assigned), "--foo=%s", input);
+    char const * argv[] = {"/mock/test.ext", "--foo", input};
+    if (assign)
+    {
+        argv[1] = assigned;
+    }
+
+    xo_args_ctx_options options;
+    memset(&options, 0, sizeof(options));
+    options.print_fn = _parsing_quiet_print;
+    xo_args_ctx * const context = xo_args_create_ctx_with_options(
+        assign ? 2 : 3, (xo_argv_t)argv, &options);
+    xo_args_arg const * const foo =
+        xo_args_declare_arg(context, "foo", NULL, NULL, NULL, type);
+    bool result = xo_args_submit(context);
+    if (result && XO_ARGS_TYPE_INT == type)
+    {
+        result = xo_args_try_get_int(foo, out_int);
+    }
+    else if (result)
+    {
+        result = xo_args_try_get_double(foo, out_double);
+    }
+    xo_args_destroy_ctx(context);
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Checks that xo-args and strtoll agree on input. Returns false on mismatch.
+static bool _parsing_int_matches(char const * const input)
+{
+    int64_t expected = 0;
+    bool const expected_ok = _parsing_strtoll(input, &expected);
+    for (int assign = 0; assign < 2; ++assign)
+    {
+        int64_t actual = 0;
+        bool const actual_ok = _parsing_xo_args(
+            input, !!assign, XO_ARGS_TYPE_INT, &actual, NULL);
+        if (expected_ok != actual_ok || (expected_ok && expected != actual))
+        {
+            printf("mismatch for \"%s\": strtoll %s %lld, xo-args %s %lld\n",
+                   input,
+                   expected_ok ? "accepted" : "rejected",
+                   (long long)expected,
+                   actual_ok ? "accepted" : "rejected",
+                   (long long)actual);
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(parsing, int_edge_cases_match_strtoll)
+{
+    char const * inputs[] = {
+        "0",
+        "-0",
+        "+0",
+        "00",
+        "1",
+        "-1",
+        "+1",
+        "9223372036854775807",
+        "9223372036854775808",
+        "-9223372036854775808",
+        "-9223372036854775809",
+        "99999999999999999999999",
+        "0x7fffffffffffffff",
+        "0x8000000000000000",
+        "-0x8000000000000000",
+        "-0x8000000000000001",
+        "0XABCDEF",
+        "0xabcdef",
+        "0x",
+        "0X",
+        "-0x",
+        "0xg",
+        "0x-1",
+        "0x+1",
+        "0x 1",
+        "0777777777777777777777",
+        "01000000000000000000000",
+        "-01000000000000000000000",
+        "-01000000000000000000001",
+        "017",
+        "018",
+        "09",
+        "0b101",
+        "0.5",
+        "1e3",
+        "",
+        "-",
+        "+",
+        "--1",
+        "+-1",
+        "-+1",
+        " 1",
+        "\t1",
+        "1 ",
+        "- 1",
+        "1a",
+        "a1",
+        "abc",
+        "1,2",
+        "12345678901234567890",
+        "-12345678901234567890",
+    };
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i)
+    {
+        EXPECT_TRUE(_parsing_int_matches(inputs[i]));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(parsing, int_random_values_match_strtoll)
+{
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    char input[64];
+    for (int i = 0; i < 20000; ++i)
+    {
+        uint64_t const bits = _parsing_next_random(&state);
+        // Spread values over every magnitude, including the int64_t limits.
+        uint64_t const magnitude = bits >> (bits & 63u);
+        char const * const sign = (bits & 0x100u)   ? "-"
+                                  : (bits & 0x200u) ? "+"
+                                                    : "";
+        switch (i % 3)
+        {
+        case 0:
+            snprintf(input,
+                     sizeof(input),
+                     "%s%llu",
+                     sign,
+                     (unsigned long long)magnitude);
+            break;
+        case 1:
+            snprintf(input,
+                     sizeof(input),
+                     "%s0%c%llx",
+                     sign,
+                     (bits & 0x400u) ? 'X' : 'x',
+                     (unsigned long long)magnitude);
+            break;
+        default:
+            snprintf(input,
+                     sizeof(input),
+                     "%s0%llo",
+                     sign,
+                     (unsigned long long)magnitude);
+            break;
+        }
+        ASSERT_TRUE(_parsing_int_matches(input));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(parsing, int_random_strings_match_strtoll)
+{
+    static char const alphabet[] = "0123456789abcdefxX+- ";
+    uint64_t state = 0x2545f4914f6cdd1dull;
+    char input[32];
+    for (int i = 0; i < 20000; ++i)
+    {
+        size_t const length = 1 + (size_t)(_parsing_next_random(&state) % 24);
+        for (size_t c = 0; c < length; ++c)
+        {
+            input[c] = alphabet[_parsing_next_random(&state)
+                                % (sizeof(alphabet) - 1)];
+        }
+        input[length] = '\0';
+        ASSERT_TRUE(_parsing_int_matches(input));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The reference: how xo-args validated doubles with strtod. The tests never
+// call setlocale so this is the "C" locale.
+static bool _parsing_strtod(char const * const input, double * const out)
+{
+    if ('\0' == input[0] || isspace((unsigned char)input[0]))
+    {
+        return false;
+    }
+    errno = 0;
+    char * end_ptr;
+    *out = strtod(input, &end_ptr);
+    return 0 == errno && '\0' == *end_ptr && input != end_ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Doubles must match bit for bit. Any NaN matches any NaN of the same sign.
+static bool _parsing_same_double(double const a, double const b)
+{
+    uint64_t a_bits;
+    uint64_t b_bits;
+    memcpy(&a_bits, &a, sizeof(a));
+    memcpy(&b_bits, &b, sizeof(b));
+    uint64_t const exponent = 0x7ff0000000000000ull;
+    uint64_t const mantissa = 0x000fffffffffffffull;
+    bool const a_nan =
+        exponent == (a_bits & exponent) && 0 != (a_bits & mantissa);
+    bool const b_nan =
+        exponent == (b_bits & exponent) && 0 != (b_bits & mantissa);
+    if (a_nan || b_nan)
+    {
+        return a_nan && b_nan && (a_bits >> 63) == (b_bits >> 63);
+    }
+    return a_bits == b_bits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Checks that xo-args and strtod agree on input. Returns false on mismatch.
+static bool _parsing_double_matches(char const * const input)
+{
+    double expected = 0.0;
+    bool const expected_ok = _parsing_strtod(input, &expected);
+    for (int assign = 0; assign < 2; ++assign)
+    {
+        double actual = 0.0;
+        bool const actual_ok = _parsing_xo_args(
+            input, !!assign, XO_ARGS_TYPE_DOUBLE, NULL, &actual);
+        if (expected_ok != actual_ok
+            || (expected_ok && !_parsing_same_double(expected, actual)))
+        {
+            printf("mismatch for \"%s\": strtod %s %a, xo-args %s %a\n",
+                   input,
+                   expected_ok ? "accepted" : "rejected",
+                   expected,
+                   actual_ok ? "accepted" : "rejected",
+                   actual);
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(parsing, double_edge_cases_match_strtod)
+{
+    char const * inputs[] = {
+        "0",
+        "-0",
+        "+0.0",
+        "1",
+        "-1.5",
+        ".5",
+        "5.",
+        ".",
+        "-.",
+        "1e10",
+        "1E-10",
+        "1e+10",
+        "1e",
+        "1e+",
+        "1e-",
+        "1ee1",
+        "1.2.3",
+        "0.1",
+        "0.2",
+        "0.3",
+        "3.14159265358979323846264338327950288",
+        "1.7976931348623157e308",
+        "1.7976931348623158e308",
+        "1.7976931348623159e308",
+        "1e309",
+        "-1e309",
+        "2.2250738585072014e-308",
+        "2.2250738585072011e-308",
+        "2.2250738585072012e-308",
+        "2.2250738585072013e-308",
+        "4.9406564584124654e-324",
+        "2.4703282292062328e-324",
+        "2.4703282292062327e-324",
+        "1e-400",
+        "0e999999999999999",
+        "0.000000000000000000000000000001e30",
+        "123456789012345678901234567890",
+        "9007199254740993",
+        "9007199254740992.5",
+        "9007199254740993.0000000000000000000000001",
+        "1e23",
+        "8.98846567431158e307",
+        "0x1p0",
+        "0X1P0",
+        "0x1.8p1",
+        "-0x1.fffffffffffffp1023",
+        "0x1.fffffffffffff8p1023",
+        "0x1p-1022",
+        "0x1p-1074",
+        "0x1p-1075",
+        "0x1.0000000000001p-1075",
+        "0x1.8p-1074",
+        "0x1.fffffffffffff8p-1023",
+        "0x1.fffffffffffff7p-1023",
+        "0x0.fffffffffffff8p-1022",
+        "0x123456789abcdef0123p0",
+        "0x.8",
+        "0x.",
+        "0x",
+        "0x1p",
+        "0x1p+",
+        "0x1.2.3",
+        "0xg",
+        "inf",
+        "-INF",
+        "Infinity",
+        "infinit",
+        "infx",
+        "nan",
+        "-NaN",
+        "nan()",
+        "nan(abc_123)",
+        "nan(",
+        "nan(a b)",
+        "nan(-)",
+        "nan(1-2)",
+        "nanx",
+        "",
+        "-",
+        "+",
+        " 1",
+        "1 ",
+        "1,5",
+        "e5",
+        "--1",
+    };
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i)
+    {
+        EXPECT_TRUE(_parsing_double_matches(inputs[i]));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Round trips random bit patterns through a few textual representations,
+// including ones with too many digits for the fast path and exact halfway
+// points between neighbouring doubles.
+UTEST(parsing, double_random_values_match_strtod)
+{
+    static char const * const formats[] = {
+        "%.17g", "%.15g", "%a", "%.25e", "%.6f"};
+    uint64_t state = 0x853c49e6748fea9bull;
+    char input[1024];
+    for (int i = 0; i < 20000; ++i)
+    {
+        uint64_t bits = _parsing_next_random(&state);
+        // Favour the exponents command lines tend to use.
+        if (i & 1)
+        {
+            bits = (bits & 0x800fffffffffffffull)
+                   | ((uint64_t)(1023 - 40 + (bits >> 52) % 80) << 52);
+        }
+        if (0x7ff0000000000000ull == (bits & 0x7ff0000000000000ull))
+        {
+            // Skip infinities and NaNs.
+            continue;
+        }
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+
+        if (i % 6 < 5)
+        {
+            snprintf(input, sizeof(input), formats[i % 6], value);
+        }
+        else
+        {
+            // The halfway point between value and the next double away from
+            // zero is exactly representable in decimal; print every digit of
+            // it. This needs a long double wider than double to be exact.
+            uint64_t const next_bits = bits + 1;
+            double next;
+            memcpy(&next, &next_bits, sizeof(next));
+            long double const half =
+                ((long double)value + (long double)next) / 2.0L;
+            snprintf(input, sizeof(input), "%.800Lg", half);
+        }
+        ASSERT_TRUE(_parsing_double_matches(input));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(parsing, double_random_strings_match_strtod)
+{
+    static char const alphabet[] = "0123456789.eE+-xXpPainf";
+    uint64_t state = 0xda3e39cb94b95bdbull;
+    char input[32];
+    for (int i = 0; i < 20000; ++i)
+    {
+        size_t const length = 1 + (size_t)(_parsing_next_random(&state) % 24);
+        for (size_t c = 0; c < length; ++c)
+        {
+            input[c] = alphabet[_parsing_next_random(&state)
+                                % (sizeof(alphabet) - 1)];
+        }
+        input[length] = '\0';
+        ASSERT_TRUE(_parsing_double_matches(input));
+    }
+}
@@ -0,0 +1,488 @@
+#include "utest.h"
+#include "xo-args-test-funcs.h"
+#include <stdlib.h>
+#include <xo-args/xo-args.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// These tests check that the cost of parsing grows linearly with the size of
+// the input. They use the default allocator rather than test_alloc because the
+// tracking allocator's own bookkeeping is not meant to scale.
+//
+// Timings are the best of a few runs to filter out noise. A linear parser is
+// expected to take roughly 10x as long for 10x the input; a quadratic one would
+// take 100x. The limits below leave plenty of room for noisy machines.
+
+////////////////////////////////////////////////////////////////////////////////
+typedef struct _scaling_input
+{
+    char const ** argv;
+    char * storage;
+    int argc;
+} _scaling_input;
+
+////////////////////////////////////////////////////////////////////////////////
+// Builds: program --foo 0 1 2 ... {value_count-1} --bar
+static _scaling_input _scaling_make_input(size_t const value_count)
+{
+    _scaling_input input;
+    input.argc = (int)value_count + 3;
+    input.argv = (char const **)malloc(sizeof(char *) * (size_t)input.argc);
+    input.storage = (char *)malloc(value_count * 16);
+
+    input.argv[0] = "/mock/test.ext";
+    input.argv[1] = "--foo";
+    for (size_t i = 0; i < value_count; ++i)
+    {
+        char * const value = &input.storage[i * 16];
+        snprintf(value, 16, "%u", (unsigned)i);
+        input.argv[i + 2] = value;
+    }
+    input.argv[input.argc - 1] = "--bar";
+    return input;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void _scaling_free_input(_scaling_input * const input)
+{
+    free((void *)input->argv);
+    free(input->storage);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the best time in nanoseconds of a few runs creating a context,
+// declaring "foo" as an array of array_type along with extra_args unrelated
+// switches, submitting and destroying it. Returns -1 if parsing failed or
+// produced the wrong number of values.
+static utest_int64_t _scaling_time_array(size_t const value_count,
+                                         XO_ARGS_ARG_FLAG const array_type,
+                                         size_t const extra_args)
+{
+    _scaling_input input = _scaling_make_input(value_count);
+    char extra_names[64][16];
+    utest_int64_t best = -1;
+    for (int run = 0; run < 3; ++run)
+    {
+        utest_int64_t const start = utest_ns();
+        xo_args_ctx * const context =
+            xo_args_create_ctx_advanced(input.argc,
+                                        (xo_argv_t)input.argv,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        test_printf);
+        xo_args_arg const * const foo =
+            xo_args_declare_arg(context, "foo", NULL, NULL, NULL, array_type);
+        xo_args_declare_arg(
+            context, "bar", NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+        for (size_t i = 0; i < extra_args && i < 64; ++i)
+        {
+            snprintf(extra_names[i],
+                     sizeof(extra_names[i]),
+                     "extra-%u",
+                     (unsigned)i);
+            xo_args_declare_arg(
+                context, extra_names[i], NULL, NULL, NULL, XO_ARGS_TYPE_SWITCH);
+        }
+        bool const submitted = xo_args_submit(context);
+
+        size_t count = 0;
+        bool got = false;
+        if (XO_ARGS_TYPE_STRING_ARRAY == array_type)
+        {
+            char const ** values = NULL;
+            got = xo_args_try_get_string_array(foo, &values, &count);
+        }
+        else if (XO_ARGS_TYPE_INT_ARRAY == array_type)
+        {
+            int64_t const * values = NULL;
+            got = xo_args_try_get_int_array(foo, &values, &count);
+        }
+        else if (XO_ARGS_TYPE_DOUBLE_ARRAY == array_type)
+        {
+            double const * values = NULL;
+            got = xo_args_try_get_double_array(foo, &values, &count);
+        }
+        xo_args_destroy_ctx(context);
+        utest_int64_t const elapsed = utest_ns() - start;
+
+        if (!submitted || !got || count != value_count)
+        {
+            best = -1;
+            break;
+        }
+        best = (best < 0 || elapsed < best) ? elapsed : best;
+    }
+    _scaling_free_input(&input);
+    return best;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(scaling, string_array_100k_values)
+{
+    utest_int64_t const small =
+        _scaling_time_array(10000, XO_ARGS_TYPE_STRING_ARRAY, 0);
+    utest_int64_t const large =
+        _scaling_time_array(100000, XO_ARGS_TYPE_STRING_ARRAY, 0);
+    ASSERT_LT(0, small);
+    ASSERT_LT(0, large);
+    // Linear growth would be ~10x; allow up to 4x that.
+    ASSERT_LT(large, small * 40);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Every value of an array is checked to see if it ends the array. That check
+// must not depend on the number of declared arguments.
+UTEST(scaling, array_values_vs_declared_args)
+{
+    utest_int64_t const few_args =
+        _scaling_time_array(100000, XO_ARGS_TYPE_INT_ARRAY, 0);
+    utest_int64_t const many_args =
+        _scaling_time_array(100000, XO_ARGS_TYPE_INT_ARRAY, 64);
+    ASSERT_LT(0, few_args);
+    ASSERT_LT(0, many_args);
+    ASSERT_LT(many_args, few_args * 4);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(scaling, int_array_1m_values)
+{
+    utest_int64_t const small =
+        _scaling_time_array(100000, XO_ARGS_TYPE_INT_ARRAY, 16);
+    utest_int64_t const large =
+        _scaling_time_array(1000000, XO_ARGS_TYPE_INT_ARRAY, 16);
+    ASSERT_LT(0, small);
+    ASSERT_LT(0, large);
+    ASSERT_LT(large, small * 40);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(scaling, double_array_1m_values)
+{
+    utest_int64_t const small =
+        _scaling_time_array(100000, XO_ARGS_TYPE_DOUBLE_ARRAY, 16);
+    utest_int64_t const large =
+        _scaling_time_array(1000000, XO_ARGS_TYPE_DOUBLE_ARRAY, 16);
+    ASSERT_LT(0, small);
+    ASSERT_LT(0, large);
+    ASSERT_LT(large, small * 40);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the best time in nanoseconds of a few runs converting every value of
+// input with strtoll (or strtod) alone.
+static utest_int64_t _scaling_time_baseline(_scaling_input const * const input,
+                                            bool const doubles)
+{
+    utest_int64_t best = -1;
+    double checksum = 0.0;
+    for (int run = 0; run < 3; ++run)
+    {
+        utest_int64_t const start = utest_ns();
+        for (int i = 2; i < input->argc - 1; ++i)
+        {
+            checksum += doubles ? strtod(input->argv[i], NULL)
+                                : (double)strtoll(input->argv[i], NULL, 0);
+        }
+        utest_int64_t const elapsed = utest_ns() - start;
+        best = (best < 0 || elapsed < best) ? elapsed : best;
+    }
+    // Keep the conversions from being optimized away.
+    return checksum > 0.0 ? best : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reports the throughput of an INT_ARRAY or DOUBLE_ARRAY next to a bare
+// strtoll or strtod loop over the same values. xo-args does more work per value
+// (array growth, checking for the end of the array) so the baseline is a point
+// of comparison, not a limit.
+static bool _scaling_report_throughput(XO_ARGS_ARG_FLAG const array_type)
+{
+    size_t const value_count = 1000000;
+    bool const doubles = XO_ARGS_TYPE_DOUBLE_ARRAY == array_type;
+    utest_int64_t const parse_ns =
+        _scaling_time_array(value_count, array_type, 0);
+
+    _scaling_input input = _scaling_make_input(value_count);
+    utest_int64_t const baseline_ns = _scaling_time_baseline(&input, doubles);
+    _scaling_free_input(&input);
+    if (parse_ns <= 0 || baseline_ns <= 0)
+    {
+        return false;
+    }
+
+    printf("  %s: %.1f ns/value (%.1f M values/s), %s alone: %.1f ns/value\n",
+           doubles ? "DOUBLE_ARRAY" : "INT_ARRAY",
+           (double)parse_ns / (double)value_count,
+           (double)value_count * 1000.0 / (double)parse_ns,
+           doubles ? "strtod" : "strtoll",
+           (double)baseline_ns / (double)value_count);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(scaling, int_array_throughput)
+{
+    ASSERT_TRUE(_scaling_report_throughput(XO_ARGS_TYPE_INT_ARRAY));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(scaling, double_array_throughput)
+{
+    ASSERT_TRUE(_scaling_report_throughput(XO_ARGS_TYPE_DOUBLE_ARRAY));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Compares passing array values as one comma delimited token with passing one
+// token per value.
+UTEST(scaling, int_array_delimited_vs_tokens)
+{
+    size_t const value_count = 1000000;
+    utest_int64_t const tokens_ns =
+        _scaling_time_array(value_count, XO_ARGS_TYPE_INT_ARRAY, 0);
+    ASSERT_LT(0, tokens_ns);
+
+    // Builds: program --foo=0,1,2,...,{value_count-1}
+    char * const list = (char *)malloc(value_count * 8 + 8);
+    size_t length = (size_t)sprintf(list, "--foo=");
+    for (size_t i = 0; i < value_count; ++i)
+    {
+        length += (size_t)sprintf(&list[length], "%u,", (unsigned)i);
+    }
+    list[length - 1] = '\0';
+    char const * argv[] = {"/mock/test.ext", list};
+
+    utest_int64_t list_ns = -1;
+    for (int run = 0; run < 3; ++run)
+    {
+        utest_int64_t const start = utest_ns();
+        xo_args_ctx * const context =
+            xo_args_create_ctx_advanced(2,
+                                        (xo_argv_t)argv,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        test_printf);
+        xo_args_arg const * const foo = xo_args_declare_arg(
+            context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_INT_ARRAY);
+        bool const submitted = xo_args_submit(context);
+        int64_t const * values = NULL;
+        size_t count = 0;
+        bool const got = xo_args_try_get_int_array(foo, &values, &count);
+        bool const last_ok = got && count == value_count
+                             && (int64_t)value_count - 1 == values[count - 1];
+        xo_args_destroy_ctx(context);
+        utest_int64_t const elapsed = utest_ns() - start;
+        ASSERT_TRUE(submitted && last_ok);
+        list_ns = (list_ns < 0 || elapsed < list_ns) ? elapsed : list_ns;
+    }
+    free(list);
+
+    printf("  INT_ARRAY one token per value: %.1f ns/value, "
+           "one delimited token: %.1f ns/value\n",
+           (double)tokens_ns / (double)value_count,
+           (double)list_ns / (double)value_count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the best time in nanoseconds of a few runs parsing a response file
+// holding "--foo 0 1 2 ... {value_count-1}" with foo as an INT_ARRAY. Returns
+// -1 if parsing failed or produced the wrong number of values.
+static utest_int64_t _scaling_time_response_file(size_t const value_count)
+{
+    char const * const path = "xo-args-scaling.rsp";
+    FILE * const file = fopen(path, "wb");
+    if (NULL == file)
+    {
+        return -1;
+    }
+    fputs("--foo", file);
+    for (size_t i = 0; i < value_count; ++i)
+    {
+        fprintf(file, (0 == i % 16) ? "\n%u" : " %u", (unsigned)i);
+    }
+    fputs("\n", file);
+    fclose(file);
+
+    char const * argv[] = {"/mock/test.ext", "@xo-args-scaling.rsp"};
+    xo_args_ctx_options options;
+    memset(&options, 0, sizeof(options));
+    options.print_fn = test_printf;
+    options.flags = XO_ARGS_CTX_RESPONSE_FILES;
+
+    utest_int64_t best = -1;
+    for (int run = 0; run < 3; ++run)
+    {
+        utest_int64_t const start = utest_ns();
+        xo_args_ctx * const context =
+            xo_args_create_ctx_with_options(2, (xo_argv_t)argv, &options);
+        xo_args_arg const * const foo = xo_args_declare_arg(
+            context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_INT_ARRAY);
+        bool const submitted = xo_args_submit(context);
+        int64_t const * values = NULL;
+        size_t count = 0;
+        bool const got = xo_args_try_get_int_array(foo, &values, &count);
+        xo_args_destroy_ctx(context);
+        utest_int64_t const elapsed = utest_ns() - start;
+
+        if (!submitted || !got || count != value_count)
+        {
+            best = -1;
+            break;
+        }
+        best = (best < 0 || elapsed < best) ? elapsed : best;
+    }
+    remove(path);
+    return best;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(scaling, response_file_1m_values)
+{
+    utest_int64_t const small = _scaling_time_response_file(100000);
+    utest_int64_t const large = _scaling_time_response_file(1000000);
+    ASSERT_LT(0, small);
+    ASSERT_LT(0, large);
+    ASSERT_LT(large, small * 40);
+    printf("  response file: %.1f ns/value\n",
+           (double)large / (double)1000000);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the best time in nanoseconds of a few runs feeding "--foo" followed
+// by value_count integers one at a time. Returns -1 if parsing failed or
+// produced the wrong number of values.
+static utest_int64_t _scaling_time_feed(size_t const value_count)
+{
+    char const * argv[] = {"/mock/test.ext"};
+    utest_int64_t best = -1;
+    for (int run = 0; run < 3; ++run)
+    {
+        utest_int64_t const start = utest_ns();
+        xo_args_ctx * const context =
+            xo_args_create_ctx_advanced(1,
+                                        (xo_argv_t)argv,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        test_printf);
+        xo_args_arg const * const foo = xo_args_declare_arg(
+            context, "foo", NULL, NULL, NULL, XO_ARGS_TYPE_INT_ARRAY);
+        bool fed = xo_args_feed(context, "--foo");
+        char token[16];
+        for (size_t i = 0; i < value_count && fed; ++i)
+        {
+            snprintf(token, sizeof(token), "%u", (unsigned)i);
+            fed = xo_args_feed(context, token);
+        }
+        bool const finished = xo_args_finish(context);
+        int64_t const * values = NULL;
+        size_t count = 0;
+        bool const got = xo_args_try_get_int_array(foo, &values, &count);
+        xo_args_destroy_ctx(context);
+        utest_int64_t const elapsed = utest_ns() - start;
+
+        if (!fed || !finished || !got || count != value_count)
+        {
+            best = -1;
+            break;
+        }
+        best = (best < 0 || elapsed < best) ? elapsed : best;
+    }
+    return best;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UTEST(scaling, feed_1m_values)
+{
+    utest_int64_t const small = _scaling_time_feed(100000);
+    utest_int64_t const large = _scaling_time_feed(1000000);
+    ASSERT_LT(0, small);
+    ASSERT_LT(0, large);
+    ASSERT_LT(large, small * 40);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Declares the arguments used by reparse_vs_recreate.
+static void _scaling_declare_command(xo_args_ctx * const context)
+{
+    char name[16];
+    for (int i = 0; i < 32; ++i)
+    {
+        snprintf(name, sizeof(name), "option-%d", i);
+        xo_args_declare_arg(context,
+                            name,
+                            NULL,
+                            "VALUE",
+                            "an option that is not used on the command line",
+                            XO_ARGS_TYPE_STRING);
+    }
+    xo_args_declare_arg(
+        context, "id", "i", NULL, "the request id", XO_ARGS_TYPE_INT);
+    xo_args_declare_arg(
+        context, "tags", "t", NULL, "tags", XO_ARGS_TYPE_STRING_ARRAY);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Compares parsing many short command lines with one context and
+// xo_args_reset_values against creating, declaring and destroying a context
+// for each one.
+UTEST(scaling, reparse_vs_recreate)
+{
+    char const * argv[] = {
+        "/mock/test.ext", "--id", "42", "--tags", "a", "b", "c"};
+    int const argc = (int)(sizeof(argv) / sizeof(argv[0]));
+    int const parses = 20000;
+
+    utest_int64_t start = utest_ns();
+    for (int i = 0; i < parses; ++i)
+    {
+        xo_args_ctx * const context =
+            xo_args_create_ctx_advanced(argc,
+                                        (xo_argv_t)argv,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        test_printf);
+        _scaling_declare_command(context);
+        ASSERT_TRUE(xo_args_submit(context));
+        xo_args_destroy_ctx(context);
+    }
+    utest_int64_t const recreate_ns = utest_ns() - start;
+
+    start = utest_ns();
+    xo_args_ctx * const context =
+        xo_args_create_ctx_advanced(argc,
+                                    (xo_argv_t)argv,
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    test_printf);
+    _scaling_declare_command(context);
+    for (int i = 0; i < parses; ++i)
+    {
+        xo_args_reset_values(context, argc, (xo_argv_t)argv);
+        ASSERT_TRUE(xo_args_submit(context));
+    }
+    xo_args_destroy_ctx(context);
+    utest_int64_t const reparse_ns = utest_ns() - start;
+
+    printf("  recreate: %.0f ns/parse, reset and reparse: %.0f ns/parse\n",
+           (double)recreate_ns / parses,
+           (double)reparse_ns / parses);
+    ASSERT_LT(reparse_ns, recreate_ns);
+}
@@ -20,6 +20,10 @@ struct program_state
     struct allocation * allocations;
     size_t allocations_size;
     size_t allocations_reserved;
+
+    size_t allocation_calls;
+    size_t allocated_bytes;
+    size_t peak_allocated_bytes;
 };
 
 static struct program_state g_program_state = { 0 };
@@ -68,8 +72,13 @@ void test_global_clear(void)
 
     g_program_state.assertion_output_size = 0;
     g_program_state.assertion_output[0] = '\0';
+    g_program_state.assertion_count = 0;
 
     g_program_state.allocations_size = 0;
+
+    g_program_state.allocation_calls = 0;
+    g_program_state.allocated_bytes = 0;
+    g_program_state.peak_allocated_bytes = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -104,6 +113,19 @@ int test_printf(char const * const fmt, ...)
     return printed;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Counts an allocation or reallocation that replaced freed bytes with
+// allocated bytes.
+static void _test_track_bytes(size_t const freed, size_t const allocated)
+{
+    ++g_program_state.allocation_calls;
+    g_program_state.allocated_bytes += allocated - freed;
+    if (g_program_state.allocated_bytes > g_program_state.peak_allocated_bytes)
+    {
+        g_program_state.peak_allocated_bytes = g_program_state.allocated_bytes;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void * test_alloc(size_t size)
 {
@@ -113,9 +135,11 @@ void * test_alloc(size_t size)
         g_program_state.allocations_reserved *= 2;
         g_program_state.allocations =
             realloc(g_program_state.allocations,
-                    sizeof(void *) * g_program_state.allocations_reserved);
+                    sizeof(struct allocation)
+                        * g_program_state.allocations_reserved);
     }
     void * const mem = malloc(size);
+    _test_track_bytes(0, size);
     g_program_state.allocations[g_program_state.allocations_size].size = size;
     g_program_state.allocations[g_program_state.allocations_size++].memory =
         mem;
@@ -130,6 +154,7 @@ void * test_realloc(void * const mem, size_t size)
         if (mem == g_program_state.allocations[i].memory)
         {
             g_program_state.allocations[i].memory = realloc(mem, size);
+            _test_track_bytes(g_program_state.allocations[i].size, size);
             g_program_state.allocations[i].size = size;
             g_program_state.allocations[i].reallocations++;
             return g_program_state.allocations[i].memory;
@@ -146,6 +171,8 @@ void test_free(void * const mem)
         if (mem == g_program_state.allocations[i].memory)
         {
             free(g_program_state.allocations[i].memory);
+            g_program_state.allocated_bytes -=
+                g_program_state.allocations[i].size;
             --g_program_state.allocations_size;
             if (i != g_program_state.allocations_size)
             {
@@ -172,6 +199,35 @@ struct allocation const * test_get_allocations(size_t * const out_count)
     return g_program_state.allocations;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+size_t test_get_allocation_calls(void)
+{
+    return g_program_state.allocation_calls;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+size_t test_get_peak_allocated_bytes(void)
+{
+    return g_program_state.peak_allocated_bytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// A measurement starts and stops on the same thread, so each thread can have a
+// clock of its own. Batch workers read the clock at the same time.
+#if defined(_MSC_VER)
+#define TEST_THREAD_LOCAL __declspec(thread)
+#else
+#define TEST_THREAD_LOCAL __thread
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+uint64_t test_clock_ns(void)
+{
+    static TEST_THREAD_LOCAL uint64_t now = 0;
+    now += 1000;
+    return now;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void test_on_assert(bool const condition, char const * const fmt, ...)
 {
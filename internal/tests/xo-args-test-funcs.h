@@ -6,6 +6,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Creates the internal state needed for test_printf, test_alloc, test_realloc
@@ -63,6 +64,22 @@ typedef struct allocation
 // Returns the array of allocations tracked via test_alloc/test_realloc
 allocation const * test_get_allocations(size_t * const out_count);
 
+////////////////////////////////////////////////////////////////////////////////
+// Returns the number of test_alloc and test_realloc calls since the last
+// test_global_setup or test_global_clear.
+size_t test_get_allocation_calls(void);
+
+////////////////////////////////////////////////////////////////////////////////
+// Returns the most bytes that were allocated at once via test_alloc and
+// test_realloc since the last test_global_setup or test_global_clear.
+size_t test_get_peak_allocated_bytes(void);
+
+////////////////////////////////////////////////////////////////////////////////
+// A clock for XO_ARGS_STATS_CLOCK_NS that advances by a microsecond every time
+// it is read so any measured time is greater than zero. Every thread has its
+// own clock so it can be read from several threads at once.
+uint64_t test_clock_ns(void);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Triggered by the XO_ARGS_ASSERT macro. When triggered the formatted message
 // will be written to an internal buffer that can be read with
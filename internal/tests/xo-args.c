@@ -3,5 +3,6 @@
 
 #define XO_ARGS_ASSERT(condition, ...)                                         \
     test_on_assert(!!(condition), __VA_ARGS__)
+#define XO_ARGS_STATS_CLOCK_NS test_clock_ns()
 #define XO_ARGS_IMPL
 #include <xo-args/xo-args.h>